@@ -0,0 +1,91 @@
+/*
+OBS Looking Glass - Custom Dynamic Multiview Plugin
+Copyright (C) 2025
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#include "config-journal.hpp"
+#include "../plugin.hpp"
+
+#include <QFile>
+
+#ifdef _WIN32
+#include <Windows.h>
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace ConfigJournal {
+
+static bool SyncToDisk(QFile &file)
+{
+	if (!file.flush())
+		return false;
+#ifdef _WIN32
+	return FlushFileBuffers((HANDLE)_get_osfhandle(file.handle())) != 0;
+#else
+	return fsync(file.handle()) == 0;
+#endif
+}
+
+bool Append(const QString &path, const QByteArray &lines)
+{
+	QFile file(path);
+	if (!file.open(QIODevice::WriteOnly | QIODevice::Append) || file.write(lines) != lines.size() ||
+	    !SyncToDisk(file)) {
+		obs_log(LOG_WARNING, "failed to append to %s: %s", path.toUtf8().constData(),
+			file.errorString().toUtf8().constData());
+		return false;
+	}
+	return true;
+}
+
+int Replay(const QString &path, const std::function<bool(const QByteArray &)> &apply)
+{
+	QFile file(path);
+	if (!file.open(QIODevice::ReadOnly))
+		return 0;
+
+	int count = 0;
+	qint64 complete = 0;
+	bool torn = false;
+	while (!file.atEnd()) {
+		QByteArray line = file.readLine();
+		if (!line.endsWith('\n')) {
+			torn = true;
+			break;
+		}
+		complete = file.pos();
+
+		line.chop(1);
+		if (line.trimmed().isEmpty())
+			continue;
+
+		if (!apply(line)) {
+			obs_log(LOG_WARNING, "skipping unreadable entry in %s", path.toUtf8().constData());
+			continue;
+		}
+		count++;
+	}
+	file.close();
+
+	// Cut the torn line off, or the next append would run into it
+	if (torn && !QFile::resize(path, complete))
+		obs_log(LOG_WARNING, "failed to truncate %s", path.toUtf8().constData());
+	return count;
+}
+
+} // namespace ConfigJournal
@@ -0,0 +1,44 @@
+/*
+OBS Looking Glass - Custom Dynamic Multiview Plugin
+Copyright (C) 2025
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#pragma once
+
+#include <QByteArray>
+#include <QString>
+
+#include <functional>
+
+/**
+ * Append-only log of config operations, one compact JSON object per line
+ * (JsonWriter output never contains a raw newline).
+ * ConfigManager appends each batch of edits and syncs it to disk, so an
+ * edit survives a crash or power loss as soon as its batch is written;
+ * the snapshot files are only rewritten when the journal is compacted.
+ * Loading reads the snapshots and replays whatever the journal still holds.
+ */
+namespace ConfigJournal {
+
+// Append lines and wait until they are on disk
+bool Append(const QString &path, const QByteArray &lines);
+
+// Call apply for each entry in order and return how many it accepted; apply
+// returns false for an entry it cannot read. A final line torn by a crash
+// mid-append is skipped and cut off.
+int Replay(const QString &path, const std::function<bool(const QByteArray &)> &apply);
+
+} // namespace ConfigJournal
@@ -18,19 +18,97 @@ with this program. If not, see <https://www.gnu.org/licenses/>
 
 #include "config-manager.hpp"
 #include "../plugin.hpp"
+#include "config-journal.hpp"
+#include "json-stream.hpp"
 #include "../ui/multiview-window.hpp"
 
 #include <obs-module.h>
 #include <obs-frontend-api.h>
 
+#include <QCryptographicHash>
 #include <QDir>
+#include <QFileInfo>
 #include <QFile>
 #include <QFont>
+#include <QPair>
 #include <QRegularExpression>
+#include <QSaveFile>
 
-ConfigManager::ConfigManager(QObject *parent) : QObject(parent) {}
+// Quiet period after the last edit before it is written to disk
+#define SAVE_DELAY_MS 500
 
-ConfigManager::~ConfigManager() {}
+// Longest wait between retries of a failing write
+#define MAX_RETRY_DELAY_MS 30000
+
+static constexpr JsonKeyName MultiviewsKey[] = {"multiviews"};
+static constexpr JsonKeyName WindowsKey[] = {"windows"};
+static constexpr JsonKeyName TemplatesKey[] = {"templates"};
+
+static constexpr JsonKeyName JournalKeys[] = {"op", "name", "new_name", "multiview", "window"};
+
+// Journal operations, in JournalOpNames order
+enum JournalOp { JournalLayout, JournalWindow, JournalRemove, JournalRename };
+static constexpr JsonKeyName JournalOpNames[] = {"layout", "window", "remove", "rename"};
+
+static QByteArray ReadConfigFile(const QString &path)
+{
+	QFile file(path);
+	if (!file.open(QIODevice::ReadOnly))
+		return QByteArray();
+	return file.readAll();
+}
+
+// Reads the array under key in a {"<key>": [...]} file. Elements that are
+// not objects are skipped; a file that does not parse yields nothing.
+template<typename T>
+static bool ReadConfigList(const QString &path, const JsonKeyName (&key)[1], bool (*read)(JsonReader &, T &),
+			   QVector<T> &items)
+{
+	QByteArray data = ReadConfigFile(path);
+	if (data.isEmpty())
+		return false;
+
+	JsonReader json(data);
+	uint32_t hash;
+	bool object = json.beginObject();
+	if (object) {
+		while (json.nextKey(key, hash)) {
+			if (!hash) {
+				json.skipValue();
+				continue;
+			}
+			items.clear();
+			if (!json.beginArray())
+				continue;
+			while (json.nextElement()) {
+				T item;
+				if (read(json, item))
+					items.append(item);
+			}
+		}
+	}
+	if (!object || !json.finish()) {
+		obs_log(LOG_WARNING, "failed to read %s", path.toUtf8().constData());
+		items.clear();
+		return false;
+	}
+	return true;
+}
+
+ConfigManager::ConfigManager(QObject *parent) : QObject(parent)
+{
+	saveTimer_.setSingleShot(true);
+	saveTimer_.setInterval(SAVE_DELAY_MS);
+	connect(&saveTimer_, &QTimer::timeout, this, [this]() { writePending(false); });
+
+	// A single writer keeps writes to the same file in order
+	writer_.setMaxThreadCount(1);
+}
+
+ConfigManager::~ConfigManager()
+{
+	flushSaves();
+}
 
 // --- Per-collection multiview CRUD ---
 
@@ -52,21 +130,30 @@ MultiviewConfig ConfigManager::getMultiview(const QString &name) const
 void ConfigManager::addMultiview(const MultiviewConfig &mv)
 {
 	multiviews_[mv.name] = mv;
-	saveCurrentCollection();
+	journalLayout(mv.name);
+	journalWindowState(mv.name);
 	emit multiviewAdded(mv.name);
 }
 
 void ConfigManager::updateMultiview(const MultiviewConfig &mv)
 {
+	// Window moves and open/close only journal the window state
+	auto it = multiviews_.constFind(mv.name);
+	bool known = it != multiviews_.constEnd();
+	bool layoutChanged = !known || !SameLayout(*it, mv);
+	bool windowChanged = !known || !SameWindowState(*it, mv);
 	multiviews_[mv.name] = mv;
-	saveCurrentCollection();
+	if (layoutChanged)
+		journalLayout(mv.name);
+	if (windowChanged)
+		journalWindowState(mv.name);
 	emit multiviewUpdated(mv.name);
 }
 
 void ConfigManager::removeMultiview(const QString &name)
 {
 	if (multiviews_.remove(name)) {
-		saveCurrentCollection();
+		journalRemove(name);
 		emit multiviewRemoved(name);
 	}
 }
@@ -78,7 +165,7 @@ void ConfigManager::renameMultiview(const QString &oldName, const QString &newNa
 	MultiviewConfig mv = multiviews_.take(oldName);
 	mv.name = newName;
 	multiviews_[newName] = mv;
-	saveCurrentCollection();
+	journalRename(oldName, newName);
 	emit multiviewRenamed(oldName, newName);
 }
 
@@ -90,7 +177,8 @@ void ConfigManager::duplicateMultiview(const QString &srcName, const QString &ne
 	mv.name = newName;
 	mv.wasOpen = false;
 	multiviews_[newName] = mv;
-	saveCurrentCollection();
+	journalLayout(newName);
+	journalWindowState(newName);
 	emit multiviewAdded(newName);
 }
 
@@ -213,6 +301,12 @@ TemplateConfig ConfigManager::defaultTemplate() const
 }
 
 // --- JSON persistence ---
+//
+// Each scene collection gets a directory under multiviews/ holding one
+// layout file per multiview, a window-state file with every window's
+// geometry, monitor, fullscreen and open flag, and a journal. Edits are
+// appended to the journal as they happen; the snapshot files they touched
+// are rewritten when the journal is compacted, which also deletes it.
 
 void ConfigManager::ensureConfigDir()
 {
@@ -223,23 +317,61 @@ void ConfigManager::ensureConfigDir()
 	}
 }
 
-QString ConfigManager::collectionConfigPath() const
+// Current scene collection name, sanitized for use as a file name
+static QString CollectionFileName()
 {
 	char *collection = obs_frontend_get_current_scene_collection();
 	QString collectionName = collection ? QString::fromUtf8(collection) : "default";
 	bfree(collection);
-	// Sanitize filename
 	collectionName.replace(QRegularExpression("[^a-zA-Z0-9_\\- ]"), "_");
+	return collectionName;
+}
 
+QString ConfigManager::collectionDir() const
+{
 	char *dir = obs_module_config_path("multiviews");
 	QString result;
 	if (dir) {
-		result = QString::fromUtf8(dir) + "/" + collectionName + ".json";
+		result = QString::fromUtf8(dir) + "/" + CollectionFileName();
 		bfree(dir);
 	}
 	return result;
 }
 
+// Single-file format used before layouts were split up; read once and
+// migrated
+QString ConfigManager::legacyCollectionPath() const
+{
+	QString dir = collectionDir();
+	return dir.isEmpty() ? QString() : dir + ".json";
+}
+
+// Sanitized names can collide ("A/B" and "A_B"), so a short hash of the
+// exact name keeps every layout in its own file
+QString ConfigManager::layoutPath(const QString &name) const
+{
+	QString dir = collectionDir();
+	if (dir.isEmpty())
+		return QString();
+
+	QString fileName = name;
+	fileName.replace(QRegularExpression("[^a-zA-Z0-9_\\- ]"), "_");
+	QByteArray hash = QCryptographicHash::hash(name.toUtf8(), QCryptographicHash::Sha1).toHex().left(8);
+	return dir + "/layouts/" + fileName + "-" + QString::fromLatin1(hash) + ".json";
+}
+
+QString ConfigManager::windowStatePath() const
+{
+	QString dir = collectionDir();
+	return dir.isEmpty() ? QString() : dir + "/window-state.json";
+}
+
+QString ConfigManager::journalPath() const
+{
+	QString dir = collectionDir();
+	return dir.isEmpty() ? QString() : dir + "/journal.jsonl";
+}
+
 QString ConfigManager::templatesConfigPath() const
 {
 	char *path = obs_module_config_path("templates.json");
@@ -255,55 +387,294 @@ void ConfigManager::loadForCurrentCollection()
 {
 	multiviews_.clear();
 
-	QString path = collectionConfigPath();
-	if (path.isEmpty())
+	// Anything still pending belongs to the collection being left, which
+	// was flushed when it was closed
+	journalPending_.clear();
+	journalEntries_ = 0;
+	dirtyLayouts_.clear();
+	removedLayouts_.clear();
+	windowStateDirty_ = false;
+	compactPending_ = false;
+
+	QString dir = collectionDir();
+	if (dir.isEmpty())
 		return;
 
-	obs_data_t *root = obs_data_create_from_json_file(path.toUtf8().constData());
-	if (!root)
+	QString legacyPath = legacyCollectionPath();
+	if (!QDir(dir).exists() && QFile::exists(legacyPath)) {
+		migrateLegacyCollection(legacyPath);
+		emit multiviewsReloaded();
 		return;
+	}
 
-	obs_data_array_t *arr = obs_data_get_array(root, "multiviews");
-	if (arr) {
-		size_t count = obs_data_array_count(arr);
-		for (size_t i = 0; i < count; i++) {
-			obs_data_t *item = obs_data_array_item(arr, i);
-			MultiviewConfig mv = MultiviewSerializer::MultiviewFromData(item);
-			if (!mv.name.isEmpty())
-				multiviews_[mv.name] = mv;
-			obs_data_release(item);
+	QDir layoutDir(dir + "/layouts");
+	const QStringList files = layoutDir.entryList({"*.json"}, QDir::Files, QDir::Name);
+	for (const QString &file : files) {
+		QByteArray data = ReadConfigFile(layoutDir.filePath(file));
+		JsonReader json(data);
+		MultiviewConfig mv;
+		if (!MultiviewSerializer::ReadMultiview(json, mv) || !json.finish()) {
+			obs_log(LOG_WARNING, "failed to read layout %s", file.toUtf8().constData());
+			continue;
 		}
-		obs_data_array_release(arr);
+		if (!mv.name.isEmpty())
+			multiviews_[mv.name] = mv;
+	}
+
+	// Window state for layouts that no longer exist is dropped on the next
+	// window-state write
+	QVector<MultiviewConfig> windows;
+	ReadConfigList(windowStatePath(), WindowsKey, MultiviewSerializer::ReadWindowState, windows);
+	for (const MultiviewConfig &window : windows) {
+		auto it = multiviews_.find(window.name);
+		if (it != multiviews_.end())
+			CopyWindowState(*it, window);
+	}
+
+	// Edits made after the last compaction, e.g. before a crash. They are
+	// folded into the snapshots right away.
+	int replayed = ConfigJournal::Replay(journalPath(),
+					     [this](const QByteArray &entry) { return replayJournalEntry(entry); });
+	if (replayed > 0) {
+		obs_log(LOG_INFO, "replayed %d journaled config changes", replayed);
+		saveCurrentCollection();
 	}
-	obs_data_release(root);
 
 	emit multiviewsReloaded();
 }
 
-void ConfigManager::saveCurrentCollection()
+bool ConfigManager::replayJournalEntry(const QByteArray &entry)
+{
+	int op = -1;
+	QString name;
+	QString newName;
+	MultiviewConfig layout;
+	MultiviewConfig window;
+	bool hasLayout = false;
+	bool hasWindow = false;
+
+	JsonReader json(entry);
+	uint32_t key;
+	bool object = json.beginObject();
+	if (object) {
+		while (json.nextKey(JournalKeys, key)) {
+			switch (key) {
+			case "op"_key:
+				op = json.readName(JournalOpNames);
+				break;
+			case "name"_key:
+				name = json.readString();
+				break;
+			case "new_name"_key:
+				newName = json.readString();
+				break;
+			case "multiview"_key:
+				hasLayout = MultiviewSerializer::ReadMultiview(json, layout);
+				break;
+			case "window"_key:
+				hasWindow = MultiviewSerializer::ReadWindowState(json, window);
+				break;
+			default:
+				json.skipValue();
+				break;
+			}
+		}
+	}
+	if (!object || !json.finish())
+		return false;
+
+	switch (op) {
+	case JournalLayout: {
+		if (!hasLayout || layout.name.isEmpty())
+			break;
+
+		// Layout entries carry no window state; keep what is known
+		auto it = multiviews_.constFind(layout.name);
+		if (it != multiviews_.constEnd())
+			CopyWindowState(layout, *it);
+		multiviews_[layout.name] = layout;
+		break;
+	}
+	case JournalWindow: {
+		auto it = multiviews_.find(window.name);
+		if (hasWindow && it != multiviews_.end())
+			CopyWindowState(*it, window);
+		break;
+	}
+	case JournalRemove:
+		multiviews_.remove(name);
+		break;
+	case JournalRename:
+		if (multiviews_.contains(name) && !multiviews_.contains(newName)) {
+			MultiviewConfig mv = multiviews_.take(name);
+			mv.name = newName;
+			multiviews_[newName] = mv;
+		}
+		break;
+	}
+	return true;
+}
+
+// Reads the old single-file format, writes it out split up, and keeps the
+// old file next to the new directory as a backup
+void ConfigManager::migrateLegacyCollection(const QString &legacyPath)
 {
+	QVector<MultiviewConfig> legacy;
+	if (!ReadConfigList(legacyPath, MultiviewsKey, MultiviewSerializer::ReadMultiview, legacy))
+		return;
+
+	for (const MultiviewConfig &mv : legacy) {
+		if (!mv.name.isEmpty())
+			multiviews_[mv.name] = mv;
+	}
+
 	if (suppressSave_)
 		return;
 
-	ensureConfigDir();
-	QString path = collectionConfigPath();
-	if (path.isEmpty())
+	saveCurrentCollection();
+	if (!flushSaves()) {
+		obs_log(LOG_WARNING, "keeping %s, its layouts could not all be written",
+			legacyPath.toUtf8().constData());
 		return;
+	}
 
-	obs_data_t *root = obs_data_create();
-	obs_data_array_t *arr = obs_data_array_create();
+	QString backupPath = legacyPath + ".bak";
+	QFile::remove(backupPath);
+	if (!QFile::rename(legacyPath, backupPath))
+		obs_log(LOG_WARNING, "failed to rename %s", legacyPath.toUtf8().constData());
+}
 
+// Full save: every layout and the window state, written on the next
+// compaction
+void ConfigManager::saveCurrentCollection()
+{
+	if (suppressSave_)
+		return;
+
+	markAllDirty();
+	saveTimer_.start();
+}
+
+// Also picks up layout files no current multiview maps to
+void ConfigManager::markAllDirty()
+{
+	QSet<QString> current;
 	for (const auto &mv : multiviews_) {
-		obs_data_t *item = MultiviewSerializer::MultiviewToData(mv);
-		obs_data_array_push_back(arr, item);
-		obs_data_release(item);
+		dirtyLayouts_.insert(mv.name);
+		current.insert(QFileInfo(layoutPath(mv.name)).fileName());
 	}
 
-	obs_data_set_array(root, "multiviews", arr);
-	obs_data_array_release(arr);
+	QString dir = collectionDir();
+	if (!dir.isEmpty()) {
+		QDir layoutDir(dir + "/layouts");
+		const QStringList files = layoutDir.entryList({"*.json"}, QDir::Files);
+		for (const QString &file : files) {
+			if (!current.contains(file))
+				removedLayouts_.append(layoutDir.filePath(file));
+		}
+	}
 
-	obs_data_save_json(root, path.toUtf8().constData());
-	obs_data_release(root);
+	windowStateDirty_ = true;
+	compactPending_ = true;
+}
+
+// Each journal entry is written straight into journalPending_, then
+// terminated here
+void ConfigManager::endJournalEntry()
+{
+	journalPending_.append('\n');
+	journalEntries_++;
+	saveTimer_.start();
+}
+
+void ConfigManager::journalLayout(const QString &name)
+{
+	if (suppressSave_)
+		return;
+
+	JsonWriter json(journalPending_);
+	json.beginObject();
+	json.field("op", "layout");
+	json.key("multiview");
+	MultiviewSerializer::WriteLayout(json, multiviews_.value(name));
+	json.endObject();
+	endJournalEntry();
+
+	dirtyLayouts_.insert(name);
+}
+
+void ConfigManager::journalWindowState(const QString &name)
+{
+	if (suppressSave_)
+		return;
+
+	JsonWriter json(journalPending_);
+	json.beginObject();
+	json.field("op", "window");
+	json.key("window");
+	MultiviewSerializer::WriteWindowState(json, multiviews_.value(name));
+	json.endObject();
+	endJournalEntry();
+
+	windowStateDirty_ = true;
+}
+
+void ConfigManager::journalRemove(const QString &name)
+{
+	if (suppressSave_)
+		return;
+
+	JsonWriter json(journalPending_);
+	json.beginObject();
+	json.field("op", "remove");
+	json.field("name", name);
+	json.endObject();
+	endJournalEntry();
+
+	dirtyLayouts_.remove(name);
+	removedLayouts_.append(layoutPath(name));
+	windowStateDirty_ = true;
+}
+
+void ConfigManager::journalRename(const QString &oldName, const QString &newName)
+{
+	if (suppressSave_)
+		return;
+
+	JsonWriter json(journalPending_);
+	json.beginObject();
+	json.field("op", "rename");
+	json.field("name", oldName);
+	json.field("new_name", newName);
+	json.endObject();
+	endJournalEntry();
+
+	dirtyLayouts_.remove(oldName);
+	removedLayouts_.append(layoutPath(oldName));
+	dirtyLayouts_.insert(newName);
+	windowStateDirty_ = true;
+}
+
+QByteArray ConfigManager::layoutJson(const MultiviewConfig &mv) const
+{
+	QByteArray out;
+	JsonWriter json(out);
+	MultiviewSerializer::WriteLayout(json, mv);
+	return out;
+}
+
+QByteArray ConfigManager::windowStateJson() const
+{
+	QByteArray out;
+	JsonWriter json(out);
+	json.beginObject();
+	json.key("windows");
+	json.beginArray();
+	for (const auto &mv : multiviews_)
+		MultiviewSerializer::WriteWindowState(json, mv);
+	json.endArray();
+	json.endObject();
+	return out;
 }
 
 void ConfigManager::loadTemplates()
@@ -318,51 +689,190 @@ void ConfigManager::loadTemplates()
 	if (path.isEmpty())
 		return;
 
-	obs_data_t *root = obs_data_create_from_json_file(path.toUtf8().constData());
-	if (!root)
+	QVector<TemplateConfig> loaded;
+	if (!ReadConfigList(path, TemplatesKey, MultiviewSerializer::ReadTemplate, loaded))
 		return;
 
-	obs_data_array_t *arr = obs_data_get_array(root, "templates");
-	if (arr) {
-		size_t count = obs_data_array_count(arr);
-		for (size_t i = 0; i < count; i++) {
-			obs_data_t *item = obs_data_array_item(arr, i);
-			TemplateConfig t = MultiviewSerializer::TemplateFromData(item);
-			if (!t.name.isEmpty())
-				templates_[t.name] = t;
-			obs_data_release(item);
-		}
-		obs_data_array_release(arr);
+	for (const TemplateConfig &t : loaded) {
+		if (!t.name.isEmpty())
+			templates_[t.name] = t;
 	}
-	obs_data_release(root);
 
 	emit templatesChanged();
 }
 
 void ConfigManager::saveTemplates()
 {
-	ensureConfigDir();
-	QString path = templatesConfigPath();
-	if (path.isEmpty())
-		return;
-
-	obs_data_t *root = obs_data_create();
-	obs_data_array_t *arr = obs_data_array_create();
+	templatesDirty_ = true;
+	saveTimer_.start();
+}
 
+QByteArray ConfigManager::templatesJson() const
+{
+	QByteArray out;
+	JsonWriter json(out);
+	json.beginObject();
+	json.key("templates");
+	json.beginArray();
 	for (const auto &t : templates_) {
 		// Don't persist the built-in default
 		if (t.name == defaultTemplate().name)
 			continue;
-		obs_data_t *item = MultiviewSerializer::TemplateToData(t);
-		obs_data_array_push_back(arr, item);
-		obs_data_release(item);
+		MultiviewSerializer::WriteTemplate(json, t);
+	}
+	json.endArray();
+	json.endObject();
+	return out;
+}
+
+// Journal entries compacted into the snapshot files at the latest
+#define COMPACT_JOURNAL_ENTRIES 64
+
+// A file to write, or to delete when json is null
+struct PendingFile {
+	QString path;
+	QByteArray json;
+};
+
+// Written to a temporary file and renamed over the old one, so a crash or
+// full disk never leaves a truncated config behind
+static bool WritePendingFile(const PendingFile &file)
+{
+	if (file.json.isNull())
+		return QFile::remove(file.path) || !QFile::exists(file.path);
+
+	QSaveFile out(file.path);
+	if (!out.open(QIODevice::WriteOnly) || out.write(file.json) != file.json.size() || !out.commit()) {
+		obs_log(LOG_WARNING, "failed to write %s: %s", file.path.toUtf8().constData(),
+			out.errorString().toUtf8().constData());
+		return false;
 	}
+	return true;
+}
+
+// One write-behind batch for the collection: new journal entries, then,
+// when compacting, the snapshot files they affect
+struct CollectionBatch {
+	QString journalPath;
+	QByteArray entries;
+	bool compact = false;
+	QVector<PendingFile> snapshot;
+};
 
-	obs_data_set_array(root, "templates", arr);
-	obs_data_array_release(arr);
+static bool WriteCollectionBatch(const CollectionBatch &batch)
+{
+	bool ok = batch.entries.isEmpty() || ConfigJournal::Append(batch.journalPath, batch.entries);
+	if (!batch.compact)
+		return ok;
+
+	for (const PendingFile &file : batch.snapshot)
+		ok = WritePendingFile(file) && ok;
 
-	obs_data_save_json(root, path.toUtf8().constData());
-	obs_data_release(root);
+	// The journal goes only once everything in it is in the snapshots
+	if (ok)
+		ok = WritePendingFile({batch.journalPath, QByteArray()});
+	return ok;
+}
+
+// Serializes pending state on the UI thread, where the configs live, and
+// hands the bytes to the writer. Target paths are resolved now, so a write
+// still in flight after a collection switch lands in the old collection.
+// Returns false if a synchronous write failed.
+bool ConfigManager::writePending(bool sync)
+{
+	saveTimer_.stop();
+
+	CollectionBatch batch;
+	batch.journalPath = journalPath();
+	batch.entries = journalPending_;
+	journalPending_.clear();
+
+	// Compact once the journal has grown, and on every flush so the next
+	// load starts from the snapshots alone
+	batch.compact = compactPending_ || journalEntries_ >= COMPACT_JOURNAL_ENTRIES || (sync && journalEntries_ > 0);
+
+	if (!batch.entries.isEmpty() || batch.compact) {
+		ensureConfigDir();
+		QString dir = collectionDir();
+		if (!dir.isEmpty())
+			QDir().mkpath(dir + "/layouts");
+	}
+
+	if (batch.compact) {
+		for (const QString &path : removedLayouts_)
+			batch.snapshot.append({path, QByteArray()});
+		for (const QString &name : dirtyLayouts_) {
+			auto it = multiviews_.constFind(name);
+			if (it != multiviews_.constEnd())
+				batch.snapshot.append({layoutPath(name), layoutJson(*it)});
+		}
+		if (windowStateDirty_)
+			batch.snapshot.append({windowStatePath(), windowStateJson()});
+
+		removedLayouts_.clear();
+		dirtyLayouts_.clear();
+		windowStateDirty_ = false;
+		compactPending_ = false;
+		journalEntries_ = 0;
+	}
+
+	PendingFile templates;
+	if (templatesDirty_) {
+		ensureConfigDir();
+		templates = {templatesConfigPath(), templatesJson()};
+		templatesDirty_ = false;
+	}
+
+	bool hasBatch = !batch.journalPath.isEmpty() && (!batch.entries.isEmpty() || batch.compact);
+	bool hasTemplates = !templates.path.isEmpty();
+
+	if (sync) {
+		writer_.waitForDone();
+		bool ok = true;
+		if (hasBatch && !WriteCollectionBatch(batch)) {
+			// Whatever did not make it is rewritten in full next time
+			markAllDirty();
+			ok = false;
+		}
+		if (hasTemplates && !WritePendingFile(templates)) {
+			templatesDirty_ = true;
+			ok = false;
+		}
+		return ok;
+	}
+
+	if (hasBatch || hasTemplates) {
+		writer_.start([this, batch, templates, hasBatch, hasTemplates]() {
+			bool batchOk = !hasBatch || WriteCollectionBatch(batch);
+			bool templatesOk = !hasTemplates || WritePendingFile(templates);
+			QMetaObject::invokeMethod(
+				this, [this, batchOk, templatesOk]() { writeFinished(batchOk, templatesOk); },
+				Qt::QueuedConnection);
+		});
+	}
+	return true;
+}
+
+// Failed writes are retried, backing off while they keep failing (disk
+// full, folder not writable). A successful write restores the normal delay.
+void ConfigManager::writeFinished(bool batchOk, bool templatesOk)
+{
+	if (!batchOk)
+		markAllDirty(); // Whatever did not make it is rewritten in full
+	if (!templatesOk)
+		templatesDirty_ = true;
+
+	if (batchOk && templatesOk) {
+		saveTimer_.setInterval(SAVE_DELAY_MS);
+		return;
+	}
+	saveTimer_.setInterval(qMin(saveTimer_.interval() * 2, MAX_RETRY_DELAY_MS));
+	saveTimer_.start();
+}
+
+bool ConfigManager::flushSaves()
+{
+	return writePending(true);
 }
 
 void ConfigManager::onSceneCollectionChanging()
@@ -373,10 +883,12 @@ void ConfigManager::onSceneCollectionChanging()
 	// Suppress further saves so that closeAll() doesn't write stale data
 	// to the new collection's file.
 	for (auto &mv : multiviews_) {
-		if (MultiviewWindow::findByName(mv.name))
+		if (MultiviewWindow::findByName(mv.name) && !mv.wasOpen) {
 			mv.wasOpen = true;
+			journalWindowState(mv.name);
+		}
 	}
-	saveCurrentCollection();
+	flushSaves();
 	suppressSave_ = true;
 }
 
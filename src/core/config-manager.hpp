@@ -19,14 +19,27 @@ with this program. If not, see <https://www.gnu.org/licenses/>
 #pragma once
 
 #include <QObject>
+#include <QByteArray>
 #include <QMap>
+#include <QSet>
 #include <QString>
+#include <QStringList>
+#include <QThreadPool>
+#include <QTimer>
 
 #include "multiview-config.hpp"
 
 /**
  * Manages multiview layouts per scene collection and global reusable templates.
  * Handles persistence to JSON files and emits signals when configs change.
+ *
+ * Each scene collection is stored as one layout file per multiview plus a
+ * window-state file, with an append-only journal of the edits made since
+ * those were last written (see ConfigJournal). Saves are write-behind: once
+ * no edit has arrived for a short quiet period, new journal entries are
+ * appended and synced on a worker thread, and every so often the journal is
+ * compacted into the snapshot files it touched. Collection switches and exit
+ * flush and compact synchronously.
  */
 class ConfigManager : public QObject {
 	Q_OBJECT
@@ -54,12 +67,16 @@ public:
 	void renameTemplate(const QString &oldName, const QString &newName);
 	TemplateConfig defaultTemplate() const;
 
-	// JSON persistence
+	// JSON persistence. The save functions only schedule a write.
 	void loadForCurrentCollection();
 	void saveCurrentCollection();
 	void loadTemplates();
 	void saveTemplates();
 
+	// Write pending changes now and wait for writes in flight. Returns
+	// false if a file could not be written.
+	bool flushSaves();
+
 	// Scene collection lifecycle
 	void onSceneCollectionChanging();
 	void onSceneCollectionChanged();
@@ -76,11 +93,41 @@ signals:
 	void templatesChanged();
 
 private:
-	QString collectionConfigPath() const;
+	QString collectionDir() const;
+	QString legacyCollectionPath() const;
+	QString layoutPath(const QString &name) const;
+	QString windowStatePath() const;
+	QString journalPath() const;
 	QString templatesConfigPath() const;
 	void ensureConfigDir();
+	void migrateLegacyCollection(const QString &legacyPath);
+
+	bool replayJournalEntry(const QByteArray &entry);
+	void markAllDirty();
+	void endJournalEntry();
+	void journalLayout(const QString &name);
+	void journalWindowState(const QString &name);
+	void journalRemove(const QString &name);
+	void journalRename(const QString &oldName, const QString &newName);
+	QByteArray layoutJson(const MultiviewConfig &mv) const;
+	QByteArray windowStateJson() const;
+	QByteArray templatesJson() const;
+	bool writePending(bool sync);
+	void writeFinished(bool batchOk, bool templatesOk);
 
 	QMap<QString, MultiviewConfig> multiviews_;
 	QMap<QString, TemplateConfig> templates_;
 	bool suppressSave_ = false;
+
+	// Write-behind state. Journal entries are appended on every write; the
+	// dirty snapshot files are written when the journal is compacted.
+	QTimer saveTimer_;           // Quiet period, or retry backoff after a failed write
+	QByteArray journalPending_;  // Entries not yet appended
+	int journalEntries_ = 0;     // Entries since the last compaction
+	QSet<QString> dirtyLayouts_; // Multiviews whose layout file needs writing
+	QStringList removedLayouts_; // Layout files to delete
+	bool windowStateDirty_ = false;
+	bool compactPending_ = false;
+	bool templatesDirty_ = false;
+	QThreadPool writer_;
 };
@@ -0,0 +1,613 @@
+/*
+OBS Looking Glass - Custom Dynamic Multiview Plugin
+Copyright (C) 2025
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#include "json-stream.hpp"
+
+#include <cstring>
+#include <limits>
+
+// Deeper nesting than any config file has; stops runaway recursion when
+// skipping values in a corrupt file
+#define MAX_DEPTH 64
+
+// --- Writer ---
+
+void JsonWriter::separator()
+{
+	if (afterKey_) {
+		afterKey_ = false;
+		return;
+	}
+	if (!first_)
+		out_.append(',');
+	first_ = false;
+}
+
+void JsonWriter::beginObject()
+{
+	separator();
+	out_.append('{');
+	first_ = true;
+}
+
+void JsonWriter::endObject()
+{
+	out_.append('}');
+	first_ = false;
+}
+
+void JsonWriter::beginArray()
+{
+	separator();
+	out_.append('[');
+	first_ = true;
+}
+
+void JsonWriter::endArray()
+{
+	out_.append(']');
+	first_ = false;
+}
+
+void JsonWriter::key(const char *name)
+{
+	if (!first_)
+		out_.append(',');
+	first_ = false;
+	out_.append('"');
+	out_.append(name);
+	out_.append("\":", 2);
+	afterKey_ = true;
+}
+
+// UTF-16 to UTF-8 with JSON escapes in one pass. Unpaired surrogates become
+// U+FFFD, as with QString::toUtf8().
+void JsonWriter::value(const QString &s)
+{
+	separator();
+
+	const QChar *data = s.constData();
+	int size = s.size();
+	out_.reserve(out_.size() + size + 2);
+	out_.append('"');
+	for (int i = 0; i < size; i++) {
+		uint32_t c = data[i].unicode();
+		if (c < 0x80) {
+			switch (c) {
+			case '"':
+				out_.append("\\\"", 2);
+				break;
+			case '\\':
+				out_.append("\\\\", 2);
+				break;
+			case '\b':
+				out_.append("\\b", 2);
+				break;
+			case '\f':
+				out_.append("\\f", 2);
+				break;
+			case '\n':
+				out_.append("\\n", 2);
+				break;
+			case '\r':
+				out_.append("\\r", 2);
+				break;
+			case '\t':
+				out_.append("\\t", 2);
+				break;
+			default:
+				if (c < 0x20) {
+					static const char hex[] = "0123456789ABCDEF";
+					char escaped[6] = {'\\', 'u', '0', '0', hex[c >> 4], hex[c & 0xF]};
+					out_.append(escaped, 6);
+				} else {
+					out_.append((char)c);
+				}
+				break;
+			}
+			continue;
+		}
+
+		if (QChar::isHighSurrogate(c) && i + 1 < size && data[i + 1].isLowSurrogate())
+			c = QChar::surrogateToUcs4((char16_t)c, data[++i].unicode());
+		else if (QChar::isSurrogate(c))
+			c = 0xFFFD;
+
+		char bytes[4];
+		int count;
+		if (c < 0x800) {
+			bytes[0] = (char)(0xC0 | (c >> 6));
+			bytes[1] = (char)(0x80 | (c & 0x3F));
+			count = 2;
+		} else if (c < 0x10000) {
+			bytes[0] = (char)(0xE0 | (c >> 12));
+			bytes[1] = (char)(0x80 | ((c >> 6) & 0x3F));
+			bytes[2] = (char)(0x80 | (c & 0x3F));
+			count = 3;
+		} else {
+			bytes[0] = (char)(0xF0 | (c >> 18));
+			bytes[1] = (char)(0x80 | ((c >> 12) & 0x3F));
+			bytes[2] = (char)(0x80 | ((c >> 6) & 0x3F));
+			bytes[3] = (char)(0x80 | (c & 0x3F));
+			count = 4;
+		}
+		out_.append(bytes, count);
+	}
+	out_.append('"');
+}
+
+void JsonWriter::value(const char *s)
+{
+	separator();
+	out_.append('"');
+	out_.append(s);
+	out_.append('"');
+}
+
+void JsonWriter::value(bool b)
+{
+	separator();
+	if (b)
+		out_.append("true", 4);
+	else
+		out_.append("false", 5);
+}
+
+void JsonWriter::value(int64_t n)
+{
+	separator();
+
+	char digits[24];
+	char *p = digits + sizeof(digits);
+	uint64_t u = n < 0 ? 0 - (uint64_t)n : (uint64_t)n;
+	do {
+		*--p = (char)('0' + u % 10);
+		u /= 10;
+	} while (u);
+	if (n < 0)
+		*--p = '-';
+	out_.append(p, (int)(digits + sizeof(digits) - p));
+}
+
+// --- Reader ---
+
+JsonReader::JsonReader(const QByteArray &json) : JsonReader(json.constData(), (size_t)json.size()) {}
+
+JsonReader::JsonReader(const char *data, size_t size) : pos_(data), end_(data + size) {}
+
+void JsonReader::fail()
+{
+	failed_ = true;
+	pos_ = end_;
+}
+
+void JsonReader::skipWhitespace()
+{
+	while (pos_ < end_ && (*pos_ == ' ' || *pos_ == '\n' || *pos_ == '\r' || *pos_ == '\t'))
+		pos_++;
+}
+
+char JsonReader::peek()
+{
+	skipWhitespace();
+	return pos_ < end_ ? *pos_ : '\0';
+}
+
+bool JsonReader::consume(char c)
+{
+	if (peek() != c)
+		return false;
+	pos_++;
+	return true;
+}
+
+bool JsonReader::beginObject()
+{
+	if (peek() != '{') {
+		skipValue();
+		return false;
+	}
+	if (++depth_ > MAX_DEPTH) {
+		fail();
+		return false;
+	}
+	pos_++;
+	first_ = true;
+	return true;
+}
+
+bool JsonReader::nextKey(const JsonKeyName *keys, size_t count, uint32_t &hash)
+{
+	hash = 0;
+	if (failed_)
+		return false;
+	if (consume('}')) {
+		depth_--;
+		first_ = false;
+		return false;
+	}
+	if (!first_ && !consume(',')) {
+		fail();
+		return false;
+	}
+	first_ = false;
+
+	const char *key;
+	size_t size;
+	if (peek() != '"' || !parseString(key, size, scratch_) || !consume(':')) {
+		fail();
+		return false;
+	}
+
+	uint32_t keyHash = JsonKeyHash(key, size);
+	for (size_t i = 0; i < count; i++) {
+		if (keys[i].hash == keyHash && keys[i].size == size && memcmp(keys[i].name, key, size) == 0) {
+			hash = keyHash;
+			break;
+		}
+	}
+	return true;
+}
+
+bool JsonReader::beginArray()
+{
+	if (peek() != '[') {
+		skipValue();
+		return false;
+	}
+	if (++depth_ > MAX_DEPTH) {
+		fail();
+		return false;
+	}
+	pos_++;
+	first_ = true;
+	return true;
+}
+
+bool JsonReader::nextElement()
+{
+	if (failed_)
+		return false;
+	if (consume(']')) {
+		depth_--;
+		first_ = false;
+		return false;
+	}
+	if (!first_ && !consume(',')) {
+		fail();
+		return false;
+	}
+	first_ = false;
+	return true;
+}
+
+static int HexValue(char c)
+{
+	if (c >= '0' && c <= '9')
+		return c - '0';
+	if (c >= 'a' && c <= 'f')
+		return c - 'a' + 10;
+	if (c >= 'A' && c <= 'F')
+		return c - 'A' + 10;
+	return -1;
+}
+
+static bool ParseHex4(const char *p, const char *end, uint32_t &value)
+{
+	if (end - p < 4)
+		return false;
+	value = 0;
+	for (int i = 0; i < 4; i++) {
+		int digit = HexValue(p[i]);
+		if (digit < 0)
+			return false;
+		value = (value << 4) | (uint32_t)digit;
+	}
+	return true;
+}
+
+static void AppendUtf8(QByteArray &out, uint32_t c)
+{
+	if (c < 0x80) {
+		out.append((char)c);
+	} else if (c < 0x800) {
+		out.append((char)(0xC0 | (c >> 6)));
+		out.append((char)(0x80 | (c & 0x3F)));
+	} else if (c < 0x10000) {
+		out.append((char)(0xE0 | (c >> 12)));
+		out.append((char)(0x80 | ((c >> 6) & 0x3F)));
+		out.append((char)(0x80 | (c & 0x3F)));
+	} else {
+		out.append((char)(0xF0 | (c >> 18)));
+		out.append((char)(0x80 | ((c >> 12) & 0x3F)));
+		out.append((char)(0x80 | ((c >> 6) & 0x3F)));
+		out.append((char)(0x80 | (c & 0x3F)));
+	}
+}
+
+// Strings without escapes are returned in place; the rest are decoded into
+// unescaped. Expects pos_ on the opening quote.
+bool JsonReader::parseString(const char *&begin, size_t &size, QByteArray &unescaped)
+{
+	const char *start = ++pos_;
+	while (pos_ < end_ && *pos_ != '"' && *pos_ != '\\') {
+		if ((uint8_t)*pos_ < 0x20)
+			return false;
+		pos_++;
+	}
+	if (pos_ >= end_)
+		return false;
+	if (*pos_ == '"') {
+		begin = start;
+		size = (size_t)(pos_ - start);
+		pos_++;
+		return true;
+	}
+
+	unescaped.clear();
+	unescaped.append(start, (int)(pos_ - start));
+	while (pos_ < end_) {
+		char c = *pos_++;
+		if (c == '"') {
+			begin = unescaped.constData();
+			size = (size_t)unescaped.size();
+			return true;
+		}
+		if ((uint8_t)c < 0x20)
+			return false;
+		if (c != '\\') {
+			unescaped.append(c);
+			continue;
+		}
+		if (pos_ >= end_)
+			return false;
+
+		switch (*pos_++) {
+		case '"':
+			unescaped.append('"');
+			break;
+		case '\\':
+			unescaped.append('\\');
+			break;
+		case '/':
+			unescaped.append('/');
+			break;
+		case 'b':
+			unescaped.append('\b');
+			break;
+		case 'f':
+			unescaped.append('\f');
+			break;
+		case 'n':
+			unescaped.append('\n');
+			break;
+		case 'r':
+			unescaped.append('\r');
+			break;
+		case 't':
+			unescaped.append('\t');
+			break;
+		case 'u': {
+			uint32_t unit;
+			if (!ParseHex4(pos_, end_, unit))
+				return false;
+			pos_ += 4;
+			if (QChar::isHighSurrogate(unit)) {
+				uint32_t low;
+				bool paired = end_ - pos_ >= 6 && pos_[0] == '\\' && pos_[1] == 'u' &&
+					      ParseHex4(pos_ + 2, end_, low) && QChar::isLowSurrogate(low);
+				if (!paired)
+					return false;
+				pos_ += 6;
+				unit = QChar::surrogateToUcs4((char16_t)unit, (char16_t)low);
+			} else if (QChar::isLowSurrogate(unit)) {
+				return false;
+			}
+			AppendUtf8(unescaped, unit);
+			break;
+		}
+		default:
+			return false;
+		}
+	}
+	return false;
+}
+
+bool JsonReader::skipLiteral(const char *literal, size_t size)
+{
+	if ((size_t)(end_ - pos_) < size || memcmp(pos_, literal, size) != 0)
+		return false;
+	pos_ += size;
+	return true;
+}
+
+// Integers outside int64 clamp; numbers with a fraction or exponent are
+// truncated, like obs_data_get_int on a double
+bool JsonReader::parseNumber(int64_t &value)
+{
+	const char *start = pos_;
+	bool negative = pos_ < end_ && *pos_ == '-';
+	if (negative)
+		pos_++;
+	if (pos_ >= end_ || *pos_ < '0' || *pos_ > '9')
+		return false;
+
+	uint64_t magnitude = 0;
+	bool overflow = false;
+	if (*pos_ == '0') {
+		pos_++;
+	} else {
+		while (pos_ < end_ && *pos_ >= '0' && *pos_ <= '9') {
+			uint64_t digit = (uint64_t)(*pos_++ - '0');
+			if (magnitude > (std::numeric_limits<uint64_t>::max() - digit) / 10)
+				overflow = true;
+			else
+				magnitude = magnitude * 10 + digit;
+		}
+	}
+
+	bool real = false;
+	if (pos_ < end_ && *pos_ == '.') {
+		real = true;
+		pos_++;
+		if (pos_ >= end_ || *pos_ < '0' || *pos_ > '9')
+			return false;
+		while (pos_ < end_ && *pos_ >= '0' && *pos_ <= '9')
+			pos_++;
+	}
+	if (pos_ < end_ && (*pos_ == 'e' || *pos_ == 'E')) {
+		real = true;
+		pos_++;
+		if (pos_ < end_ && (*pos_ == '+' || *pos_ == '-'))
+			pos_++;
+		if (pos_ >= end_ || *pos_ < '0' || *pos_ > '9')
+			return false;
+		while (pos_ < end_ && *pos_ >= '0' && *pos_ <= '9')
+			pos_++;
+	}
+
+	const int64_t max = std::numeric_limits<int64_t>::max();
+	const int64_t min = std::numeric_limits<int64_t>::min();
+	if (real) {
+		double d = QByteArray::fromRawData(start, (int)(pos_ - start)).toDouble();
+		value = d >= 9.2e18 ? max : d <= -9.2e18 ? min : (int64_t)d;
+	} else if (negative) {
+		value = overflow || magnitude > (uint64_t)max + 1 ? min : (int64_t)(0 - magnitude);
+	} else {
+		value = overflow || magnitude > (uint64_t)max ? max : (int64_t)magnitude;
+	}
+	return true;
+}
+
+QString JsonReader::readString()
+{
+	if (peek() != '"') {
+		skipValue();
+		return QString();
+	}
+
+	const char *begin;
+	size_t size;
+	if (!parseString(begin, size, scratch_)) {
+		fail();
+		return QString();
+	}
+	return QString::fromUtf8(begin, (int)size);
+}
+
+int64_t JsonReader::readInt()
+{
+	char c = peek();
+	if (c != '-' && (c < '0' || c > '9')) {
+		skipValue();
+		return 0;
+	}
+
+	int64_t value;
+	if (!parseNumber(value)) {
+		fail();
+		return 0;
+	}
+	return value;
+}
+
+bool JsonReader::readBool()
+{
+	char c = peek();
+	if (c == 't') {
+		if (!skipLiteral("true", 4))
+			fail();
+		return !failed_;
+	}
+	skipValue();
+	return false;
+}
+
+int JsonReader::readName(const JsonKeyName *names, size_t count)
+{
+	if (peek() != '"') {
+		skipValue();
+		return -1;
+	}
+
+	const char *begin;
+	size_t size;
+	if (!parseString(begin, size, scratch_)) {
+		fail();
+		return -1;
+	}
+
+	uint32_t hash = JsonKeyHash(begin, size);
+	for (size_t i = 0; i < count; i++) {
+		if (names[i].hash == hash && names[i].size == size && memcmp(names[i].name, begin, size) == 0)
+			return (int)i;
+	}
+	return -1;
+}
+
+void JsonReader::skipValue()
+{
+	const char *begin;
+	size_t size;
+	int64_t number;
+
+	switch (peek()) {
+	case '"':
+		if (!parseString(begin, size, scratch_))
+			fail();
+		break;
+	case '{': {
+		uint32_t hash;
+		if (beginObject()) {
+			while (nextKey(nullptr, 0, hash))
+				skipValue();
+		}
+		break;
+	}
+	case '[':
+		if (beginArray()) {
+			while (nextElement())
+				skipValue();
+		}
+		break;
+	case 't':
+		if (!skipLiteral("true", 4))
+			fail();
+		break;
+	case 'f':
+		if (!skipLiteral("false", 5))
+			fail();
+		break;
+	case 'n':
+		if (!skipLiteral("null", 4))
+			fail();
+		break;
+	default:
+		if (!parseNumber(number))
+			fail();
+		break;
+	}
+}
+
+bool JsonReader::finish()
+{
+	skipWhitespace();
+	if (pos_ != end_ || depth_ != 0)
+		fail();
+	return !failed_;
+}
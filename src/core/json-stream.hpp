@@ -0,0 +1,151 @@
+/*
+OBS Looking Glass - Custom Dynamic Multiview Plugin
+Copyright (C) 2025
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#pragma once
+
+#include <QByteArray>
+#include <QString>
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Streaming JSON for the config files. JsonWriter appends compact JSON
+ * straight into a byte buffer, and JsonReader pulls values from a buffer
+ * without building a document tree. The config structs are filled field by
+ * field with no intermediate objects, and UTF-16 strings are encoded
+ * without temporaries.
+ *
+ * Object keys are dispatched by a compile-time hash (see "name"_key). A
+ * reader lists the keys it knows in a JsonKeyName table. nextKey()
+ * compares a key's text only against table entries with the same hash, and
+ * reports unknown keys as 0. Duplicate case labels are compile errors, so
+ * a switch over the hashes also checks that the known keys never collide.
+ *
+ * Values are typed as leniently as obs_data reads them: a value of the
+ * wrong type reads as empty, 0 or false, and fractional numbers read as
+ * integers truncate.
+ */
+
+// FNV-1a; never 0, which nextKey() reserves for unknown keys
+constexpr uint32_t JsonKeyHash(const char *s, size_t size)
+{
+	uint32_t hash = 2166136261u;
+	for (size_t i = 0; i < size; i++)
+		hash = (hash ^ (uint8_t)s[i]) * 16777619u;
+	return hash ? hash : 1;
+}
+
+constexpr uint32_t operator""_key(const char *s, size_t size)
+{
+	return JsonKeyHash(s, size);
+}
+
+struct JsonKeyName {
+	const char *name;
+	size_t size;
+	uint32_t hash;
+
+	template<size_t N>
+	constexpr JsonKeyName(const char (&s)[N]) : name(s), size(N - 1), hash(JsonKeyHash(s, N - 1))
+	{
+	}
+};
+
+class JsonWriter {
+public:
+	explicit JsonWriter(QByteArray &out) : out_(out) {}
+
+	void beginObject();
+	void endObject();
+	void beginArray();
+	void endArray();
+
+	// Keys are ASCII literals and are written unescaped
+	void key(const char *name);
+
+	void value(const QString &s);
+	void value(const char *s); // ASCII only, e.g. enum names
+	void value(bool b);
+	void value(int n) { value((int64_t)n); }
+	void value(int64_t n);
+
+	template<typename T> void field(const char *name, const T &v)
+	{
+		key(name);
+		value(v);
+	}
+
+private:
+	void separator();
+
+	QByteArray &out_;
+	bool first_ = true;     // Nothing written yet in the current container
+	bool afterKey_ = false; // The next value belongs to a key just written
+};
+
+class JsonReader {
+public:
+	explicit JsonReader(const QByteArray &json);
+	JsonReader(const char *data, size_t size);
+
+	// Objects: beginObject(), then nextKey() until it returns false, reading
+	// or skipping one value per key. False from beginObject() means the
+	// value was not an object and has been skipped.
+	bool beginObject();
+	template<size_t N> bool nextKey(const JsonKeyName (&keys)[N], uint32_t &hash)
+	{
+		return nextKey(keys, N, hash);
+	}
+
+	// Arrays: beginArray(), then nextElement() before each value
+	bool beginArray();
+	bool nextElement();
+
+	QString readString();
+	int64_t readInt();
+	bool readBool();
+
+	// Index of a string value in names, or -1 for any other value
+	template<size_t N> int readName(const JsonKeyName (&names)[N]) { return readName(names, N); }
+
+	void skipValue();
+
+	// True once the whole input was consumed without a syntax error
+	bool finish();
+	bool failed() const { return failed_; }
+
+private:
+	bool nextKey(const JsonKeyName *keys, size_t count, uint32_t &hash);
+	int readName(const JsonKeyName *names, size_t count);
+
+	void skipWhitespace();
+	char peek();
+	bool consume(char c);
+	bool parseString(const char *&begin, size_t &size, QByteArray &unescaped);
+	bool skipLiteral(const char *literal, size_t size);
+	bool parseNumber(int64_t &value);
+	void fail();
+
+	const char *pos_;
+	const char *end_;
+	int depth_ = 0;
+	bool first_ = false; // No element read yet in the current container
+	bool failed_ = false;
+	QByteArray scratch_; // Strings and keys that contain escapes
+};
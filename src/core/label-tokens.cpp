@@ -0,0 +1,221 @@
+/*
+OBS Looking Glass - Custom Dynamic Multiview Plugin
+Copyright (C) 2025
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#include "label-tokens.hpp"
+#include "tally-state.hpp"
+#include "../plugin.hpp"
+
+#include <obs-frontend-api.h>
+
+#include <QTime>
+
+#include <cstring>
+
+static QString FrontendSceneName(bool preview)
+{
+	obs_source_t *scene = preview ? obs_frontend_get_current_preview_scene() : obs_frontend_get_current_scene();
+	QString name = scene ? QString::fromUtf8(obs_source_get_name(scene)) : QString();
+	obs_source_release(scene);
+	return name;
+}
+
+// Empty for cells that show no scene (sources, canvases, placeholders)
+static QString SceneToken(const WidgetConfig &widget)
+{
+	switch (widget.type) {
+	case WidgetType::Scene:
+		return widget.sceneName;
+	case WidgetType::Preview:
+		return FrontendSceneName(GetTallyState()->studioMode());
+	case WidgetType::Program:
+		return FrontendSceneName(false);
+	default:
+		return QString();
+	}
+}
+
+static double CanvasFps()
+{
+	struct obs_video_info ovi;
+	if (!obs_get_video_info(&ovi) || ovi.fps_den == 0)
+		return 0.0;
+	return (double)ovi.fps_num / (double)ovi.fps_den;
+}
+
+// Frame rate a source is set up to deliver, for the source types whose
+// settings say so; 0 if unknown
+static double ConfiguredFps(obs_source_t *source)
+{
+	const char *id = obs_source_get_unversioned_id(source);
+	if (!id)
+		return 0.0;
+
+	obs_data_t *settings = obs_source_get_settings(source);
+	double fps = 0.0;
+	if (strcmp(id, "dshow_input") == 0) {
+		// Frame interval in 100 ns units; -1 follows the output rate and
+		// 0 is the device's highest
+		int64_t interval = obs_data_get_int(settings, "frame_interval");
+		if (interval > 0)
+			fps = 10000000.0 / (double)interval;
+		else if (interval == -1)
+			fps = CanvasFps();
+	} else if (strcmp(id, "v4l2_input") == 0) {
+		// Time per frame, packed as numerator << 16 | denominator
+		int64_t packed = obs_data_get_int(settings, "framerate");
+		int64_t num = (packed >> 16) & 0xFFFF;
+		int64_t den = packed & 0xFFFF;
+		if (packed > 0 && num > 0)
+			fps = (double)den / (double)num;
+	} else if (strcmp(id, "av_capture_input") == 0) {
+		struct media_frames_per_second rate;
+		if (obs_data_get_frames_per_second(settings, "frame_rate", &rate, nullptr) && rate.denominator > 0)
+			fps = (double)rate.numerator / (double)rate.denominator;
+	} else if (strcmp(id, "browser_source") == 0) {
+		fps = obs_data_get_bool(settings, "fps_custom") ? (double)obs_data_get_int(settings, "fps")
+								  : CanvasFps();
+	}
+	obs_data_release(settings);
+	return fps;
+}
+
+// Nominal rates rather than measured ones, which jitter and would make
+// every refresh look like a label change. Scenes and synchronous sources
+// render once per output frame; async sources (cameras, capture cards,
+// media) report the rate from their settings, or nothing if it is unknown.
+static QString FpsToken(const WidgetConfig &widget, obs_source_t *source)
+{
+	double fps = 0.0;
+	switch (widget.type) {
+	case WidgetType::Preview:
+	case WidgetType::Program:
+	case WidgetType::Canvas:
+	case WidgetType::Scene:
+		fps = CanvasFps();
+		break;
+	case WidgetType::Source:
+		if (!source)
+			break;
+		fps = ConfiguredFps(source);
+		if (fps <= 0.0 && !(obs_source_get_output_flags(source) & OBS_SOURCE_ASYNC_VIDEO))
+			fps = CanvasFps();
+		break;
+	default:
+		break;
+	}
+
+	if (fps <= 0.0)
+		return QString();
+	return QString::number(fps, 'f', qAbs(fps - qRound(fps)) < 0.005 ? 0 : 2);
+}
+
+static QString ResolutionToken(obs_source_t *source)
+{
+	uint32_t cx = 0;
+	uint32_t cy = 0;
+	if (source) {
+		cx = obs_source_get_width(source);
+		cy = obs_source_get_height(source);
+	} else {
+		struct obs_video_info ovi;
+		if (obs_get_video_info(&ovi)) {
+			cx = ovi.base_width;
+			cy = ovi.base_height;
+		}
+	}
+	return QStringLiteral("%1x%2").arg(cx).arg(cy);
+}
+
+static QString TallyToken(const WidgetConfig &widget, obs_source_t *source)
+{
+	TallyState *tally = GetTallyState();
+	uint32_t state = TALLY_NONE;
+	if (widget.type == WidgetType::Program)
+		state = TALLY_PROGRAM;
+	else if (widget.type == WidgetType::Preview)
+		state = tally->studioMode() ? TALLY_PREVIEW : TALLY_PROGRAM;
+	else if (source)
+		state = tally->stateFor(source);
+
+	if (state & TALLY_PROGRAM)
+		return QString::fromUtf8(LG_TEXT("Label.TallyProgram"));
+	if (state & TALLY_PREVIEW)
+		return QString::fromUtf8(LG_TEXT("Label.TallyPreview"));
+	return QString();
+}
+
+static QString RecordingDurationToken()
+{
+	uint64_t seconds = 0;
+	struct obs_video_info ovi;
+	obs_output_t *output = obs_frontend_recording_active() ? obs_frontend_get_recording_output() : nullptr;
+	if (output && obs_get_video_info(&ovi) && ovi.fps_num > 0)
+		seconds = (uint64_t)obs_output_get_total_frames(output) * ovi.fps_den / ovi.fps_num;
+	obs_output_release(output);
+
+	return QStringLiteral("%1:%2:%3")
+		.arg(seconds / 3600, 2, 10, QLatin1Char('0'))
+		.arg((seconds / 60) % 60, 2, 10, QLatin1Char('0'))
+		.arg(seconds % 60, 2, 10, QLatin1Char('0'));
+}
+
+namespace LabelTokens {
+
+bool HasTokens(const QString &text)
+{
+	int open = text.indexOf(QLatin1Char('{'));
+	return open >= 0 && text.indexOf(QLatin1Char('}'), open) > open;
+}
+
+QString Expand(const QString &text, const WidgetConfig &widget, obs_source_t *source)
+{
+	QString result;
+	result.reserve(text.size());
+
+	int pos = 0;
+	while (pos < text.size()) {
+		int open = text.indexOf(QLatin1Char('{'), pos);
+		int close = open >= 0 ? text.indexOf(QLatin1Char('}'), open) : -1;
+		if (close < 0) {
+			result += text.mid(pos);
+			break;
+		}
+
+		result += text.mid(pos, open - pos);
+		QString token = text.mid(open + 1, close - open - 1);
+		if (token == QLatin1String("scene"))
+			result += SceneToken(widget);
+		else if (token == QLatin1String("source.fps"))
+			result += FpsToken(widget, source);
+		else if (token == QLatin1String("source.resolution"))
+			result += ResolutionToken(source);
+		else if (token == QLatin1String("tally"))
+			result += TallyToken(widget, source);
+		else if (token == QLatin1String("time"))
+			result += QTime::currentTime().toString(QStringLiteral("HH:mm:ss"));
+		else if (token == QLatin1String("rec.duration"))
+			result += RecordingDurationToken();
+		else
+			result += text.mid(open, close - open + 1);
+		pos = close + 1;
+	}
+
+	return result;
+}
+
+} // namespace LabelTokens
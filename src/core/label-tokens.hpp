@@ -0,0 +1,51 @@
+/*
+OBS Looking Glass - Custom Dynamic Multiview Plugin
+Copyright (C) 2025
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#pragma once
+
+#include "multiview-config.hpp"
+
+#include <obs.h>
+
+#include <QString>
+
+/**
+ * Live tokens in custom label text, expanded on the UI thread:
+ *
+ *   {scene}             Scene shown by a Scene, Preview or Program cell;
+ *                       empty for other cells
+ *   {source.fps}        Frame rate of the cell's content: the canvas rate for
+ *                       scenes and the output, the configured rate for
+ *                       cameras and capture cards, empty if unknown
+ *   {source.resolution} Native size of the cell's content, e.g. 1920x1080
+ *   {tally}             PGM / PVW when the content is live or previewed
+ *   {time}              Local wall clock time
+ *   {rec.duration}      Elapsed recording time
+ *
+ * Unknown tokens are left as written. Cells with tokens are re-expanded on
+ * the window's label refresh timer; only labels whose expanded text changed
+ * are laid out and rasterized again.
+ */
+namespace LabelTokens {
+
+bool HasTokens(const QString &text);
+
+// Expand the tokens in text for a cell showing source (may be null)
+QString Expand(const QString &text, const WidgetConfig &widget, obs_source_t *source);
+
+} // namespace LabelTokens
@@ -17,6 +17,7 @@ with this program. If not, see <https://www.gnu.org/licenses/>
 */
 
 #include "multiview-config.hpp"
+#include "json-stream.hpp"
 
 // --- String conversion helpers for enum serialization ---
 
@@ -40,25 +41,6 @@ static const char *WidgetTypeToString(WidgetType t)
 	}
 }
 
-static WidgetType StringToWidgetType(const char *s)
-{
-	if (!s)
-		return WidgetType::None;
-	if (strcmp(s, "preview") == 0)
-		return WidgetType::Preview;
-	if (strcmp(s, "program") == 0)
-		return WidgetType::Program;
-	if (strcmp(s, "canvas") == 0)
-		return WidgetType::Canvas;
-	if (strcmp(s, "scene") == 0)
-		return WidgetType::Scene;
-	if (strcmp(s, "source") == 0)
-		return WidgetType::Source;
-	if (strcmp(s, "placeholder") == 0)
-		return WidgetType::Placeholder;
-	return WidgetType::None;
-}
-
 static const char *AlignHToString(Qt::Alignment a)
 {
 	if (a & Qt::AlignLeft)
@@ -68,17 +50,6 @@ static const char *AlignHToString(Qt::Alignment a)
 	return "center";
 }
 
-static Qt::Alignment StringToAlignH(const char *s)
-{
-	if (!s)
-		return Qt::AlignHCenter;
-	if (strcmp(s, "left") == 0)
-		return Qt::AlignLeft;
-	if (strcmp(s, "right") == 0)
-		return Qt::AlignRight;
-	return Qt::AlignHCenter;
-}
-
 static const char *AlignVToString(Qt::Alignment a)
 {
 	if (a & Qt::AlignTop)
@@ -88,134 +59,378 @@ static const char *AlignVToString(Qt::Alignment a)
 	return "middle";
 }
 
-static Qt::Alignment StringToAlignV(const char *s)
+// Names read back through readName(); anything else reads as the default
+static constexpr JsonKeyName WidgetTypeNames[] = {"preview", "program", "canvas", "scene", "source", "placeholder"};
+static const WidgetType WidgetTypeValues[] = {WidgetType::Preview, WidgetType::Program, WidgetType::Canvas,
+					      WidgetType::Scene, WidgetType::Source, WidgetType::Placeholder};
+
+static constexpr JsonKeyName AlignHNames[] = {"left", "right"};
+static const Qt::Alignment AlignHValues[] = {Qt::AlignLeft, Qt::AlignRight};
+
+static constexpr JsonKeyName AlignVNames[] = {"top", "bottom"};
+static const Qt::Alignment AlignVValues[] = {Qt::AlignTop, Qt::AlignBottom};
+
+bool operator==(const WidgetConfig &a, const WidgetConfig &b)
+{
+	return a.type == b.type && a.sceneName == b.sceneName && a.sourceName == b.sourceName &&
+	       a.placeholderPath == b.placeholderPath && a.canvasName == b.canvasName &&
+	       a.labelVisible == b.labelVisible && a.labelHAlign == b.labelHAlign && a.labelVAlign == b.labelVAlign &&
+	       a.labelText == b.labelText && a.labelFont == b.labelFont && a.labelBgColor == b.labelBgColor &&
+	       a.safeRegion == b.safeRegion && a.showStatus == b.showStatus && a.maxFps == b.maxFps &&
+	       a.renderScale == b.renderScale;
+}
+
+bool operator==(const CellConfig &a, const CellConfig &b)
+{
+	return a.row == b.row && a.col == b.col && a.rowSpan == b.rowSpan && a.colSpan == b.colSpan &&
+	       a.widget == b.widget;
+}
+
+bool SameLayout(const MultiviewConfig &a, const MultiviewConfig &b)
+{
+	return a.name == b.name && a.gridRows == b.gridRows && a.gridCols == b.gridCols &&
+	       a.gridBorderWidth == b.gridBorderWidth && a.gridLineColor == b.gridLineColor &&
+	       a.compositorMode == b.compositorMode && a.labelRefreshMs == b.labelRefreshMs && a.cells == b.cells;
+}
+
+bool SameWindowState(const MultiviewConfig &a, const MultiviewConfig &b)
+{
+	return a.geometry == b.geometry && a.monitorId == b.monitorId && a.fullscreen == b.fullscreen &&
+	       a.wasOpen == b.wasOpen;
+}
+
+void CopyWindowState(MultiviewConfig &to, const MultiviewConfig &from)
 {
-	if (!s)
-		return Qt::AlignTop;
-	if (strcmp(s, "top") == 0)
-		return Qt::AlignTop;
-	if (strcmp(s, "bottom") == 0)
-		return Qt::AlignBottom;
-	return Qt::AlignVCenter;
+	to.geometry = from.geometry;
+	to.monitorId = from.monitorId;
+	to.fullscreen = from.fullscreen;
+	to.wasOpen = from.wasOpen;
 }
 
 namespace MultiviewSerializer {
 
-obs_data_t *WidgetToData(const WidgetConfig &w)
+static constexpr JsonKeyName WidgetKeys[] = {"type", "scene_name", "source_name", "placeholder_path", "canvas_name",
+					       "label_visible", "label_h_align", "label_v_align", "label_text",
+					       "label_font", "label_bg_color", "safe_region", "show_status", "max_fps",
+					       "render_scale"};
+
+static constexpr JsonKeyName CellKeys[] = {"row", "col", "row_span", "col_span", "widget"};
+
+static constexpr JsonKeyName MultiviewKeys[] = {"name", "grid_rows", "grid_cols", "grid_border_width",
+						"grid_line_color", "compositor_mode", "label_refresh_ms", "cells",
+						"geometry_x", "geometry_y", "geometry_w", "geometry_h", "monitor_id",
+						"fullscreen", "was_open"};
+
+static constexpr JsonKeyName WindowStateKeys[] = {"name", "geometry_x", "geometry_y", "geometry_w",
+						  "geometry_h", "monitor_id", "fullscreen", "was_open"};
+
+static constexpr JsonKeyName TemplateKeys[] = {"name", "grid_rows", "grid_cols", "preserve_sources", "cells"};
+
+void WriteWidget(JsonWriter &json, const WidgetConfig &w)
 {
-	obs_data_t *data = obs_data_create();
-	obs_data_set_string(data, "type", WidgetTypeToString(w.type));
-	obs_data_set_string(data, "scene_name", w.sceneName.toUtf8().constData());
-	obs_data_set_string(data, "source_name", w.sourceName.toUtf8().constData());
-	obs_data_set_string(data, "placeholder_path", w.placeholderPath.toUtf8().constData());
-	obs_data_set_string(data, "canvas_name", w.canvasName.toUtf8().constData());
-	obs_data_set_bool(data, "label_visible", w.labelVisible);
-	obs_data_set_string(data, "label_h_align", AlignHToString(w.labelHAlign));
-	obs_data_set_string(data, "label_v_align", AlignVToString(w.labelVAlign));
-	obs_data_set_string(data, "label_text", w.labelText.toUtf8().constData());
-	obs_data_set_string(data, "label_font", w.labelFont.toUtf8().constData());
-	obs_data_set_string(data, "label_bg_color", w.labelBgColor.name(QColor::HexArgb).toUtf8().constData());
-	obs_data_set_bool(data, "safe_region", w.safeRegion);
-	obs_data_set_bool(data, "show_status", w.showStatus);
-	return data;
+	json.beginObject();
+	json.field("type", WidgetTypeToString(w.type));
+	json.field("scene_name", w.sceneName);
+	json.field("source_name", w.sourceName);
+	json.field("placeholder_path", w.placeholderPath);
+	json.field("canvas_name", w.canvasName);
+	json.field("label_visible", w.labelVisible);
+	json.field("label_h_align", AlignHToString(w.labelHAlign));
+	json.field("label_v_align", AlignVToString(w.labelVAlign));
+	json.field("label_text", w.labelText);
+	json.field("label_font", w.labelFont);
+	json.field("label_bg_color", w.labelBgColor.name(QColor::HexArgb));
+	json.field("safe_region", w.safeRegion);
+	json.field("show_status", w.showStatus);
+	json.field("max_fps", w.maxFps);
+	json.field("render_scale", w.renderScale);
+	json.endObject();
 }
 
-WidgetConfig WidgetFromData(obs_data_t *data)
+bool ReadWidget(JsonReader &json, WidgetConfig &w)
 {
-	WidgetConfig w;
-	w.type = StringToWidgetType(obs_data_get_string(data, "type"));
-	w.sceneName = QString::fromUtf8(obs_data_get_string(data, "scene_name"));
-	w.sourceName = QString::fromUtf8(obs_data_get_string(data, "source_name"));
-	w.placeholderPath = QString::fromUtf8(obs_data_get_string(data, "placeholder_path"));
-	w.canvasName = QString::fromUtf8(obs_data_get_string(data, "canvas_name"));
-	w.labelVisible = obs_data_get_bool(data, "label_visible");
-	w.labelHAlign = StringToAlignH(obs_data_get_string(data, "label_h_align"));
-	w.labelVAlign = StringToAlignV(obs_data_get_string(data, "label_v_align"));
-	w.labelText = QString::fromUtf8(obs_data_get_string(data, "label_text"));
-	w.labelFont = QString::fromUtf8(obs_data_get_string(data, "label_font"));
-
-	QString bgColorStr = QString::fromUtf8(obs_data_get_string(data, "label_bg_color"));
+	if (!json.beginObject())
+		return false;
+
+	w = WidgetConfig();
+	w.labelVisible = false;
+	w.labelVAlign = Qt::AlignVCenter;
+	w.renderScale = 0;
+	QString bgColorStr;
+
+	uint32_t key;
+	while (json.nextKey(WidgetKeys, key)) {
+		switch (key) {
+		case "type"_key: {
+			int i = json.readName(WidgetTypeNames);
+			w.type = i >= 0 ? WidgetTypeValues[i] : WidgetType::None;
+			break;
+		}
+		case "scene_name"_key:
+			w.sceneName = json.readString();
+			break;
+		case "source_name"_key:
+			w.sourceName = json.readString();
+			break;
+		case "placeholder_path"_key:
+			w.placeholderPath = json.readString();
+			break;
+		case "canvas_name"_key:
+			w.canvasName = json.readString();
+			break;
+		case "label_visible"_key:
+			w.labelVisible = json.readBool();
+			break;
+		case "label_h_align"_key: {
+			int i = json.readName(AlignHNames);
+			w.labelHAlign = i >= 0 ? AlignHValues[i] : Qt::AlignHCenter;
+			break;
+		}
+		case "label_v_align"_key: {
+			int i = json.readName(AlignVNames);
+			w.labelVAlign = i >= 0 ? AlignVValues[i] : Qt::AlignVCenter;
+			break;
+		}
+		case "label_text"_key:
+			w.labelText = json.readString();
+			break;
+		case "label_font"_key:
+			w.labelFont = json.readString();
+			break;
+		case "label_bg_color"_key:
+			bgColorStr = json.readString();
+			break;
+		case "safe_region"_key:
+			w.safeRegion = json.readBool();
+			break;
+		case "show_status"_key:
+			w.showStatus = json.readBool();
+			break;
+		case "max_fps"_key:
+			w.maxFps = (int)json.readInt();
+			break;
+		case "render_scale"_key:
+			w.renderScale = (int)json.readInt();
+			break;
+		default:
+			json.skipValue();
+			break;
+		}
+	}
+
 	if (!bgColorStr.isEmpty())
 		w.labelBgColor = QColor(bgColorStr);
 	else
 		w.labelBgColor = QColor(0, 0, 0, 128);
 
-	w.safeRegion = obs_data_get_bool(data, "safe_region");
-	w.showStatus = obs_data_get_bool(data, "show_status");
+	if (w.maxFps < 0)
+		w.maxFps = 0;
+	if (w.renderScale <= 0 || w.renderScale > 100)
+		w.renderScale = 100;
 
-	return w;
+	return true;
 }
 
-obs_data_t *CellToData(const CellConfig &c)
+void WriteCell(JsonWriter &json, const CellConfig &c)
 {
-	obs_data_t *data = obs_data_create();
-	obs_data_set_int(data, "row", c.row);
-	obs_data_set_int(data, "col", c.col);
-	obs_data_set_int(data, "row_span", c.rowSpan);
-	obs_data_set_int(data, "col_span", c.colSpan);
-
-	obs_data_t *widgetData = WidgetToData(c.widget);
-	obs_data_set_obj(data, "widget", widgetData);
-	obs_data_release(widgetData);
-
-	return data;
+	json.beginObject();
+	json.field("row", c.row);
+	json.field("col", c.col);
+	json.field("row_span", c.rowSpan);
+	json.field("col_span", c.colSpan);
+	json.key("widget");
+	WriteWidget(json, c.widget);
+	json.endObject();
 }
 
-CellConfig CellFromData(obs_data_t *data)
+bool ReadCell(JsonReader &json, CellConfig &c)
 {
-	CellConfig c;
-	c.row = (int)obs_data_get_int(data, "row");
-	c.col = (int)obs_data_get_int(data, "col");
-	c.rowSpan = (int)obs_data_get_int(data, "row_span");
-	c.colSpan = (int)obs_data_get_int(data, "col_span");
+	if (!json.beginObject())
+		return false;
+
+	c = CellConfig();
+	c.rowSpan = 0;
+	c.colSpan = 0;
+
+	uint32_t key;
+	while (json.nextKey(CellKeys, key)) {
+		switch (key) {
+		case "row"_key:
+			c.row = (int)json.readInt();
+			break;
+		case "col"_key:
+			c.col = (int)json.readInt();
+			break;
+		case "row_span"_key:
+			c.rowSpan = (int)json.readInt();
+			break;
+		case "col_span"_key:
+			c.colSpan = (int)json.readInt();
+			break;
+		case "widget"_key:
+			ReadWidget(json, c.widget);
+			break;
+		default:
+			json.skipValue();
+			break;
+		}
+	}
+
 	if (c.rowSpan <= 0)
 		c.rowSpan = 1;
 	if (c.colSpan <= 0)
 		c.colSpan = 1;
+	return true;
+}
 
-	obs_data_t *widgetData = obs_data_get_obj(data, "widget");
-	if (widgetData) {
-		c.widget = WidgetFromData(widgetData);
-		obs_data_release(widgetData);
+static void WriteCells(JsonWriter &json, const QVector<CellConfig> &cells)
+{
+	json.key("cells");
+	json.beginArray();
+	for (const auto &cell : cells)
+		WriteCell(json, cell);
+	json.endArray();
+}
+
+// Non-object elements are skipped, as obs_data_array_item() would have
+static void ReadCells(JsonReader &json, QVector<CellConfig> &cells)
+{
+	cells.clear();
+	if (!json.beginArray())
+		return;
+	while (json.nextElement()) {
+		CellConfig cell;
+		if (ReadCell(json, cell))
+			cells.append(cell);
 	}
-	return c;
 }
 
-obs_data_t *MultiviewToData(const MultiviewConfig &mv)
+static void WriteLayoutFields(JsonWriter &json, const MultiviewConfig &mv)
+{
+	json.field("name", mv.name);
+	json.field("grid_rows", mv.gridRows);
+	json.field("grid_cols", mv.gridCols);
+	json.field("grid_border_width", mv.gridBorderWidth);
+	json.field("grid_line_color", mv.gridLineColor.name(QColor::HexArgb));
+	json.field("compositor_mode", mv.compositorMode);
+	json.field("label_refresh_ms", mv.labelRefreshMs);
+	WriteCells(json, mv.cells);
+}
+
+static void WriteWindowStateFields(JsonWriter &json, const MultiviewConfig &mv)
+{
+	json.field("geometry_x", mv.geometry.x());
+	json.field("geometry_y", mv.geometry.y());
+	json.field("geometry_w", mv.geometry.width());
+	json.field("geometry_h", mv.geometry.height());
+	json.field("monitor_id", mv.monitorId);
+	json.field("fullscreen", mv.fullscreen);
+	json.field("was_open", mv.wasOpen);
+}
+
+// Window state keys shared by full configs and window state entries.
+// Returns false for any other key, leaving its value unread.
+static bool ReadWindowStateField(JsonReader &json, uint32_t key, int (&geometry)[4], MultiviewConfig &mv)
 {
-	obs_data_t *data = obs_data_create();
-	obs_data_set_string(data, "name", mv.name.toUtf8().constData());
-	obs_data_set_int(data, "grid_rows", mv.gridRows);
-	obs_data_set_int(data, "grid_cols", mv.gridCols);
-	obs_data_set_int(data, "grid_border_width", mv.gridBorderWidth);
-	obs_data_set_string(data, "grid_line_color", mv.gridLineColor.name(QColor::HexArgb).toUtf8().constData());
-	obs_data_set_int(data, "geometry_x", mv.geometry.x());
-	obs_data_set_int(data, "geometry_y", mv.geometry.y());
-	obs_data_set_int(data, "geometry_w", mv.geometry.width());
-	obs_data_set_int(data, "geometry_h", mv.geometry.height());
-	obs_data_set_int(data, "monitor_id", mv.monitorId);
-	obs_data_set_bool(data, "fullscreen", mv.fullscreen);
-	obs_data_set_bool(data, "was_open", mv.wasOpen);
-
-	obs_data_array_t *cellsArray = obs_data_array_create();
-	for (const auto &cell : mv.cells) {
-		obs_data_t *cellData = CellToData(cell);
-		obs_data_array_push_back(cellsArray, cellData);
-		obs_data_release(cellData);
+	switch (key) {
+	case "geometry_x"_key:
+		geometry[0] = (int)json.readInt();
+		return true;
+	case "geometry_y"_key:
+		geometry[1] = (int)json.readInt();
+		return true;
+	case "geometry_w"_key:
+		geometry[2] = (int)json.readInt();
+		return true;
+	case "geometry_h"_key:
+		geometry[3] = (int)json.readInt();
+		return true;
+	case "monitor_id"_key:
+		mv.monitorId = (int)json.readInt();
+		return true;
+	case "fullscreen"_key:
+		mv.fullscreen = json.readBool();
+		return true;
+	case "was_open"_key:
+		mv.wasOpen = json.readBool();
+		return true;
+	default:
+		return false;
 	}
-	obs_data_set_array(data, "cells", cellsArray);
-	obs_data_array_release(cellsArray);
+}
+
+static void SetGeometry(const int (&geometry)[4], MultiviewConfig &mv)
+{
+	int gw = geometry[2] > 0 ? geometry[2] : 1280;
+	int gh = geometry[3] > 0 ? geometry[3] : 720;
+	mv.geometry = QRect(geometry[0], geometry[1], gw, gh);
+}
 
-	return data;
+void WriteMultiview(JsonWriter &json, const MultiviewConfig &mv)
+{
+	json.beginObject();
+	WriteLayoutFields(json, mv);
+	WriteWindowStateFields(json, mv);
+	json.endObject();
+}
+
+void WriteLayout(JsonWriter &json, const MultiviewConfig &mv)
+{
+	json.beginObject();
+	WriteLayoutFields(json, mv);
+	json.endObject();
 }
 
-MultiviewConfig MultiviewFromData(obs_data_t *data)
+bool ReadMultiview(JsonReader &json, MultiviewConfig &mv)
 {
-	MultiviewConfig mv;
-	mv.name = QString::fromUtf8(obs_data_get_string(data, "name"));
-	mv.gridRows = (int)obs_data_get_int(data, "grid_rows");
-	mv.gridCols = (int)obs_data_get_int(data, "grid_cols");
-	mv.gridBorderWidth = (int)obs_data_get_int(data, "grid_border_width");
+	if (!json.beginObject())
+		return false;
+
+	mv = MultiviewConfig();
+	mv.gridRows = 0;
+	mv.gridCols = 0;
+	mv.gridBorderWidth = 0;
+	mv.labelRefreshMs = 0;
+	mv.monitorId = 0;
+	QString lineColorStr;
+	int geometry[4] = {};
+
+	uint32_t key;
+	while (json.nextKey(MultiviewKeys, key)) {
+		if (ReadWindowStateField(json, key, geometry, mv))
+			continue;
+
+		switch (key) {
+		case "name"_key:
+			mv.name = json.readString();
+			break;
+		case "grid_rows"_key:
+			mv.gridRows = (int)json.readInt();
+			break;
+		case "grid_cols"_key:
+			mv.gridCols = (int)json.readInt();
+			break;
+		case "grid_border_width"_key:
+			mv.gridBorderWidth = (int)json.readInt();
+			break;
+		case "grid_line_color"_key:
+			lineColorStr = json.readString();
+			break;
+		case "compositor_mode"_key:
+			mv.compositorMode = json.readBool();
+			break;
+		case "label_refresh_ms"_key:
+			mv.labelRefreshMs = (int)json.readInt();
+			break;
+		case "cells"_key:
+			ReadCells(json, mv.cells);
+			break;
+		default:
+			json.skipValue();
+			break;
+		}
+	}
+
 	if (mv.gridRows <= 0)
 		mv.gridRows = 4;
 	if (mv.gridCols <= 0)
@@ -225,83 +440,104 @@ MultiviewConfig MultiviewFromData(obs_data_t *data)
 	if (mv.gridBorderWidth > 10)
 		mv.gridBorderWidth = 10;
 
-	QString lineColorStr = QString::fromUtf8(obs_data_get_string(data, "grid_line_color"));
 	if (!lineColorStr.isEmpty())
 		mv.gridLineColor = QColor(lineColorStr);
 	else
 		mv.gridLineColor = QColor(255, 255, 255);
 
-	int gx = (int)obs_data_get_int(data, "geometry_x");
-	int gy = (int)obs_data_get_int(data, "geometry_y");
-	int gw = (int)obs_data_get_int(data, "geometry_w");
-	int gh = (int)obs_data_get_int(data, "geometry_h");
-	if (gw <= 0)
-		gw = 1280;
-	if (gh <= 0)
-		gh = 720;
-	mv.geometry = QRect(gx, gy, gw, gh);
-	mv.monitorId = (int)obs_data_get_int(data, "monitor_id");
-	mv.fullscreen = obs_data_get_bool(data, "fullscreen");
-	mv.wasOpen = obs_data_get_bool(data, "was_open");
-
-	obs_data_array_t *cellsArray = obs_data_get_array(data, "cells");
-	if (cellsArray) {
-		size_t count = obs_data_array_count(cellsArray);
-		for (size_t i = 0; i < count; i++) {
-			obs_data_t *cellData = obs_data_array_item(cellsArray, i);
-			mv.cells.append(CellFromData(cellData));
-			obs_data_release(cellData);
-		}
-		obs_data_array_release(cellsArray);
-	}
+	if (mv.labelRefreshMs <= 0)
+		mv.labelRefreshMs = 1000;
+	if (mv.labelRefreshMs < 100)
+		mv.labelRefreshMs = 100;
+	if (mv.labelRefreshMs > 10000)
+		mv.labelRefreshMs = 10000;
 
-	return mv;
+	SetGeometry(geometry, mv);
+	return true;
 }
 
-obs_data_t *TemplateToData(const TemplateConfig &t)
+void WriteWindowState(JsonWriter &json, const MultiviewConfig &mv)
 {
-	obs_data_t *data = obs_data_create();
-	obs_data_set_string(data, "name", t.name.toUtf8().constData());
-	obs_data_set_int(data, "grid_rows", t.gridRows);
-	obs_data_set_int(data, "grid_cols", t.gridCols);
-	obs_data_set_bool(data, "preserve_sources", t.preserveSources);
-
-	obs_data_array_t *cellsArray = obs_data_array_create();
-	for (const auto &cell : t.cells) {
-		obs_data_t *cellData = CellToData(cell);
-		obs_data_array_push_back(cellsArray, cellData);
-		obs_data_release(cellData);
+	json.beginObject();
+	json.field("name", mv.name);
+	WriteWindowStateFields(json, mv);
+	json.endObject();
+}
+
+bool ReadWindowState(JsonReader &json, MultiviewConfig &mv)
+{
+	if (!json.beginObject())
+		return false;
+
+	mv.name.clear();
+	mv.monitorId = 0;
+	mv.fullscreen = false;
+	mv.wasOpen = false;
+	int geometry[4] = {};
+
+	uint32_t key;
+	while (json.nextKey(WindowStateKeys, key)) {
+		if (ReadWindowStateField(json, key, geometry, mv))
+			continue;
+		if (key == "name"_key)
+			mv.name = json.readString();
+		else
+			json.skipValue();
 	}
-	obs_data_set_array(data, "cells", cellsArray);
-	obs_data_array_release(cellsArray);
 
-	return data;
+	SetGeometry(geometry, mv);
+	return true;
 }
 
-TemplateConfig TemplateFromData(obs_data_t *data)
+void WriteTemplate(JsonWriter &json, const TemplateConfig &t)
 {
-	TemplateConfig t;
-	t.name = QString::fromUtf8(obs_data_get_string(data, "name"));
-	t.gridRows = (int)obs_data_get_int(data, "grid_rows");
-	t.gridCols = (int)obs_data_get_int(data, "grid_cols");
-	t.preserveSources = obs_data_get_bool(data, "preserve_sources");
-	if (t.gridRows <= 0)
-		t.gridRows = 4;
-	if (t.gridCols <= 0)
-		t.gridCols = 4;
+	json.beginObject();
+	json.field("name", t.name);
+	json.field("grid_rows", t.gridRows);
+	json.field("grid_cols", t.gridCols);
+	json.field("preserve_sources", t.preserveSources);
+	WriteCells(json, t.cells);
+	json.endObject();
+}
 
-	obs_data_array_t *cellsArray = obs_data_get_array(data, "cells");
-	if (cellsArray) {
-		size_t count = obs_data_array_count(cellsArray);
-		for (size_t i = 0; i < count; i++) {
-			obs_data_t *cellData = obs_data_array_item(cellsArray, i);
-			t.cells.append(CellFromData(cellData));
-			obs_data_release(cellData);
+bool ReadTemplate(JsonReader &json, TemplateConfig &t)
+{
+	if (!json.beginObject())
+		return false;
+
+	t = TemplateConfig();
+	t.gridRows = 0;
+	t.gridCols = 0;
+
+	uint32_t key;
+	while (json.nextKey(TemplateKeys, key)) {
+		switch (key) {
+		case "name"_key:
+			t.name = json.readString();
+			break;
+		case "grid_rows"_key:
+			t.gridRows = (int)json.readInt();
+			break;
+		case "grid_cols"_key:
+			t.gridCols = (int)json.readInt();
+			break;
+		case "preserve_sources"_key:
+			t.preserveSources = json.readBool();
+			break;
+		case "cells"_key:
+			ReadCells(json, t.cells);
+			break;
+		default:
+			json.skipValue();
+			break;
 		}
-		obs_data_array_release(cellsArray);
 	}
 
-	return t;
+	if (t.gridRows <= 0)
+		t.gridRows = 4;
+	if (t.gridCols <= 0)
+		t.gridCols = 4;
+	return true;
 }
 
 } // namespace MultiviewSerializer
@@ -24,7 +24,8 @@ with this program. If not, see <https://www.gnu.org/licenses/>
 #include <QColor>
 #include <Qt>
 
-#include <obs-data.h>
+class JsonWriter;
+class JsonReader;
 
 // Content types that can be displayed in a multiview cell
 enum class WidgetType {
@@ -52,6 +53,8 @@ struct WidgetConfig {
 	QColor labelBgColor = QColor(0, 0, 0, 128); // Label background color with alpha
 	bool safeRegion = false;                    // Draw broadcast safe area overlays
 	bool showStatus = false;                    // Show preview/program border indicator
+	int maxFps = 0;                             // Content update rate cap; 0 = every frame
+	int renderScale = 100;                      // Content render resolution in percent
 };
 
 // Position and span of a single cell within the grid
@@ -63,6 +66,18 @@ struct CellConfig {
 	WidgetConfig widget;
 };
 
+// Field-by-field comparison, used to find the cells a config edit touched
+bool operator==(const WidgetConfig &a, const WidgetConfig &b);
+bool operator==(const CellConfig &a, const CellConfig &b);
+inline bool operator!=(const WidgetConfig &a, const WidgetConfig &b)
+{
+	return !(a == b);
+}
+inline bool operator!=(const CellConfig &a, const CellConfig &b)
+{
+	return !(a == b);
+}
+
 // Complete layout definition for a multiview window
 struct MultiviewConfig {
 	QString name;
@@ -70,6 +85,8 @@ struct MultiviewConfig {
 	int gridCols = 4;
 	int gridBorderWidth = 6;
 	QColor gridLineColor = QColor(255, 255, 255);
+	bool compositorMode = false; // Render every cell through one display per window
+	int labelRefreshMs = 1000;   // How often label tokens such as {time} are re-expanded
 	QVector<CellConfig> cells;
 	QRect geometry = QRect(100, 100, 1280, 720);
 	int monitorId = -1;
@@ -77,6 +94,12 @@ struct MultiviewConfig {
 	bool wasOpen = false;
 };
 
+// Layout and window state are stored in separate files; these tell which of
+// the two an edit changed
+bool SameLayout(const MultiviewConfig &a, const MultiviewConfig &b);
+bool SameWindowState(const MultiviewConfig &a, const MultiviewConfig &b);
+void CopyWindowState(MultiviewConfig &to, const MultiviewConfig &from);
+
 // Reusable layout template (no window state)
 // When preserveSources is true, the template retains exact widget types and
 // source/scene names. When false, non-structural widgets are reset to placeholders.
@@ -88,19 +111,31 @@ struct TemplateConfig {
 	bool preserveSources = false;
 };
 
-// Serialization helpers for persisting configs to OBS JSON data objects
+// Serialization to and from the JSON config files. Readers return false
+// when the value is not an object; it is skipped, and the struct is left
+// as it was. Missing keys and values of the wrong type read as obs_data
+// defaults, then fall back to the same values as an empty config.
 namespace MultiviewSerializer {
 
-obs_data_t *WidgetToData(const WidgetConfig &w);
-WidgetConfig WidgetFromData(obs_data_t *data);
+void WriteWidget(JsonWriter &json, const WidgetConfig &w);
+bool ReadWidget(JsonReader &json, WidgetConfig &w);
+
+void WriteCell(JsonWriter &json, const CellConfig &c);
+bool ReadCell(JsonReader &json, CellConfig &c);
+
+// Full config, layout and window state. ReadMultiview also reads layout
+// files, which have no window state, leaving it at its defaults.
+void WriteMultiview(JsonWriter &json, const MultiviewConfig &mv);
+bool ReadMultiview(JsonReader &json, MultiviewConfig &mv);
 
-obs_data_t *CellToData(const CellConfig &c);
-CellConfig CellFromData(obs_data_t *data);
+// Layout only: grid, appearance and cells
+void WriteLayout(JsonWriter &json, const MultiviewConfig &mv);
 
-obs_data_t *MultiviewToData(const MultiviewConfig &mv);
-MultiviewConfig MultiviewFromData(obs_data_t *data);
+// Name plus geometry, monitor, fullscreen and open flag
+void WriteWindowState(JsonWriter &json, const MultiviewConfig &mv);
+bool ReadWindowState(JsonReader &json, MultiviewConfig &mv);
 
-obs_data_t *TemplateToData(const TemplateConfig &t);
-TemplateConfig TemplateFromData(obs_data_t *data);
+void WriteTemplate(JsonWriter &json, const TemplateConfig &t);
+bool ReadTemplate(JsonReader &json, TemplateConfig &t);
 
 } // namespace MultiviewSerializer
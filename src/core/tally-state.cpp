@@ -0,0 +1,100 @@
+/*
+OBS Looking Glass - Custom Dynamic Multiview Plugin
+Copyright (C) 2025
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#include "tally-state.hpp"
+
+TallyState::TallyState() {}
+
+TallyState::~TallyState()
+{
+	clear();
+}
+
+void TallyState::onFrontendEvent(enum obs_frontend_event event)
+{
+	switch (event) {
+	case OBS_FRONTEND_EVENT_SCENE_CHANGED:
+	case OBS_FRONTEND_EVENT_PREVIEW_SCENE_CHANGED:
+	case OBS_FRONTEND_EVENT_STUDIO_MODE_ENABLED:
+	case OBS_FRONTEND_EVENT_STUDIO_MODE_DISABLED:
+	case OBS_FRONTEND_EVENT_SCENE_COLLECTION_CHANGED:
+	case OBS_FRONTEND_EVENT_FINISHED_LOADING:
+		refresh();
+		break;
+
+	case OBS_FRONTEND_EVENT_SCENE_COLLECTION_CHANGING:
+	case OBS_FRONTEND_EVENT_EXIT:
+		clear();
+		break;
+
+	default:
+		break;
+	}
+}
+
+void TallyState::refresh()
+{
+	bool studioMode = obs_frontend_preview_program_mode_active();
+
+	// Only the pointer identity is published; the references are dropped
+	// immediately so the tally never keeps a scene alive.
+	obs_source_t *program = obs_frontend_get_current_scene();
+	programScene_.store(program, std::memory_order_release);
+	obs_source_release(program);
+
+	obs_source_t *preview = studioMode ? obs_frontend_get_current_preview_scene() : nullptr;
+	previewScene_.store(preview, std::memory_order_release);
+	{
+		std::lock_guard<std::mutex> lock(previewMutex_);
+		obs_weak_source_release(previewWeak_);
+		previewWeak_ = preview ? obs_source_get_weak_source(preview) : nullptr;
+	}
+	obs_source_release(preview);
+
+	studioMode_.store(studioMode, std::memory_order_release);
+}
+
+void TallyState::clear()
+{
+	programScene_.store(nullptr, std::memory_order_release);
+	previewScene_.store(nullptr, std::memory_order_release);
+	studioMode_.store(false, std::memory_order_release);
+
+	std::lock_guard<std::mutex> lock(previewMutex_);
+	obs_weak_source_release(previewWeak_);
+	previewWeak_ = nullptr;
+}
+
+obs_source_t *TallyState::previewSceneRef()
+{
+	std::lock_guard<std::mutex> lock(previewMutex_);
+	return previewWeak_ ? obs_weak_source_get_source(previewWeak_) : nullptr;
+}
+
+uint32_t TallyState::stateFor(const obs_source_t *source) const
+{
+	if (!source)
+		return TALLY_NONE;
+
+	uint32_t state = TALLY_NONE;
+	if (source == programScene_.load(std::memory_order_acquire))
+		state |= TALLY_PROGRAM;
+	if (source == previewScene_.load(std::memory_order_acquire))
+		state |= TALLY_PREVIEW;
+	return state;
+}
@@ -0,0 +1,68 @@
+/*
+OBS Looking Glass - Custom Dynamic Multiview Plugin
+Copyright (C) 2025
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#pragma once
+
+#include <obs.h>
+#include <obs-frontend-api.h>
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+// Tally bits reported for a source
+enum TallyFlags : uint32_t {
+	TALLY_NONE = 0,
+	TALLY_PROGRAM = 1 << 0,
+	TALLY_PREVIEW = 1 << 1,
+};
+
+/**
+ * Shared program/preview tally for all multiview cells.
+ * Updated on the UI thread from frontend scene and studio-mode events and
+ * published as atomics, so renderers on the graphics thread can look up a
+ * source's tally without calling into the frontend API or taking locks.
+ */
+class TallyState {
+public:
+	TallyState();
+	~TallyState();
+
+	void onFrontendEvent(enum obs_frontend_event event);
+
+	// Re-query the current program/preview scenes from the frontend (UI thread)
+	void refresh();
+	void clear();
+
+	// Lock-free lookups, safe from any thread
+	uint32_t stateFor(const obs_source_t *source) const;
+	bool studioMode() const { return studioMode_.load(std::memory_order_acquire); }
+
+	// Strong reference to the studio-mode preview scene (caller releases).
+	// Meant to be taken once per frame by RenderFrameContext, not per cell.
+	obs_source_t *previewSceneRef();
+
+private:
+	// Identity only; never dereferenced outside the UI thread
+	std::atomic<const obs_source_t *> programScene_{nullptr};
+	std::atomic<const obs_source_t *> previewScene_{nullptr};
+	std::atomic<bool> studioMode_{false};
+
+	std::mutex previewMutex_;
+	obs_weak_source_t *previewWeak_ = nullptr;
+};
@@ -18,8 +18,17 @@ with this program. If not, see <https://www.gnu.org/licenses/>
 
 #include "plugin.hpp"
 #include "core/config-manager.hpp"
+#include "core/tally-state.hpp"
 #include "ui/tools-menu.hpp"
 #include "ui/multiview-window.hpp"
+#include "render/source-texture-cache.hpp"
+#include "render/source-resolver.hpp"
+#include "render/frame-context.hpp"
+#include "render/render-governor.hpp"
+#include "render/overlay-batcher.hpp"
+#include "render/label-atlas.hpp"
+#include "render/image-cache.hpp"
+#include "render/gpu-release-queue.hpp"
 
 #include <obs-module.h>
 #include <obs-frontend-api.h>
@@ -38,9 +47,16 @@ MODULE_EXPORT const char *obs_module_name(void)
 	return obs_module_text("LookingGlass");
 }
 
-// Global singleton instances for configuration and menu management
+// Global singleton instances for configuration, menu and render management
 static ConfigManager *s_configManager = nullptr;
 static ToolsMenuManager *s_toolsMenuManager = nullptr;
+static SourceTextureCache *s_sourceTextureCache = nullptr;
+static TallyState *s_tallyState = nullptr;
+static RenderFrameContext *s_renderFrameContext = nullptr;
+static RenderGovernor *s_renderGovernor = nullptr;
+static LabelAtlas *s_labelAtlas = nullptr;
+static ImageCache *s_imageCache = nullptr;
+static GpuReleaseQueue *s_gpuReleaseQueue = nullptr;
 
 ConfigManager *GetConfigManager()
 {
@@ -52,8 +68,46 @@ ToolsMenuManager *GetToolsMenuManager()
 	return s_toolsMenuManager;
 }
 
+SourceTextureCache *GetSourceTextureCache()
+{
+	return s_sourceTextureCache;
+}
+
+TallyState *GetTallyState()
+{
+	return s_tallyState;
+}
+
+RenderFrameContext *GetRenderFrameContext()
+{
+	return s_renderFrameContext;
+}
+
+RenderGovernor *GetRenderGovernor()
+{
+	return s_renderGovernor;
+}
+
+LabelAtlas *GetLabelAtlas()
+{
+	return s_labelAtlas;
+}
+
+ImageCache *GetImageCache()
+{
+	return s_imageCache;
+}
+
+GpuReleaseQueue *GetGpuReleaseQueue()
+{
+	return s_gpuReleaseQueue;
+}
+
 static void on_frontend_event(enum obs_frontend_event event, void *)
 {
+	// Keep the shared tally current before windows react to the event
+	s_tallyState->onFrontendEvent(event);
+
 	switch (event) {
 	case OBS_FRONTEND_EVENT_SCENE_COLLECTION_CHANGING:
 		// Save state and suppress further saves before closing windows,
@@ -80,6 +134,14 @@ static void on_frontend_event(enum obs_frontend_event event, void *)
 		// Save open-window state before closing so they reopen on next launch
 		s_configManager->onSceneCollectionChanging();
 		MultiviewWindow::closeAll();
+		// Release pooled windows and cached renders while the graphics
+		// subsystem is still up
+		MultiviewWindow::releasePool();
+		s_sourceTextureCache->clear();
+		s_labelAtlas->clear();
+		s_imageCache->clear();
+		OverlayBatcher::ReleaseEffect();
+		s_gpuReleaseQueue->drain();
 		break;
 
 	default:
@@ -93,6 +155,14 @@ bool obs_module_load(void)
 
 	s_configManager = new ConfigManager();
 	s_toolsMenuManager = new ToolsMenuManager();
+	s_sourceTextureCache = new SourceTextureCache();
+	s_tallyState = new TallyState();
+	s_renderFrameContext = new RenderFrameContext();
+	s_renderGovernor = new RenderGovernor();
+	s_labelAtlas = new LabelAtlas();
+	s_imageCache = new ImageCache();
+	s_gpuReleaseQueue = new GpuReleaseQueue();
+	SourceResolver::Initialize();
 
 	obs_frontend_add_event_callback(on_frontend_event, nullptr);
 
@@ -104,6 +174,28 @@ void obs_module_unload(void)
 	obs_log(LOG_INFO, "plugin unloaded");
 
 	obs_frontend_remove_event_callback(on_frontend_event, nullptr);
+	SourceResolver::Shutdown();
+
+	delete s_sourceTextureCache;
+	s_sourceTextureCache = nullptr;
+
+	delete s_imageCache;
+	s_imageCache = nullptr;
+
+	delete s_labelAtlas;
+	s_labelAtlas = nullptr;
+
+	delete s_renderGovernor;
+	s_renderGovernor = nullptr;
+
+	delete s_renderFrameContext;
+	s_renderFrameContext = nullptr;
+
+	delete s_gpuReleaseQueue;
+	s_gpuReleaseQueue = nullptr;
+
+	delete s_tallyState;
+	s_tallyState = nullptr;
 
 	delete s_toolsMenuManager;
 	s_toolsMenuManager = nullptr;
@@ -27,6 +27,20 @@ with this program. If not, see <https://www.gnu.org/licenses/>
 
 class ConfigManager;
 class ToolsMenuManager;
+class SourceTextureCache;
+class TallyState;
+class RenderFrameContext;
+class RenderGovernor;
+class LabelAtlas;
+class ImageCache;
+class GpuReleaseQueue;
 
 ConfigManager *GetConfigManager();
 ToolsMenuManager *GetToolsMenuManager();
+SourceTextureCache *GetSourceTextureCache();
+TallyState *GetTallyState();
+RenderFrameContext *GetRenderFrameContext();
+RenderGovernor *GetRenderGovernor();
+LabelAtlas *GetLabelAtlas();
+ImageCache *GetImageCache();
+GpuReleaseQueue *GetGpuReleaseQueue();
@@ -0,0 +1,137 @@
+/*
+OBS Looking Glass - Custom Dynamic Multiview Plugin
+Copyright (C) 2025
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#include "frame-context.hpp"
+#include "../plugin.hpp"
+#include "gpu-release-queue.hpp"
+#include "../core/tally-state.hpp"
+
+RenderFrameContext::RenderFrameContext()
+{
+	obs_add_tick_callback(TickCallback, this);
+}
+
+RenderFrameContext::~RenderFrameContext()
+{
+	obs_remove_tick_callback(TickCallback, this);
+	clear();
+}
+
+void RenderFrameContext::TickCallback(void *data, float)
+{
+	// Runs on the graphics thread once per frame before any display draws
+	auto *self = (RenderFrameContext *)data;
+	self->clear();
+	self->frame_++;
+
+	// GPU objects released by closed windows since the last frame
+	GetGpuReleaseQueue()->drain();
+}
+
+void RenderFrameContext::clear()
+{
+	for (CanvasInfo &info : canvases_)
+		obs_canvas_release(info.canvas);
+	canvases_.clear();
+
+	obs_source_release(previewScene_);
+	previewScene_ = nullptr;
+
+	built_ = false;
+}
+
+void RenderFrameContext::build()
+{
+	if (built_)
+		return;
+	built_ = true;
+
+	struct obs_video_info ovi;
+	videoValid_ = obs_get_video_info(&ovi) && ovi.base_width > 0 && ovi.base_height > 0;
+	baseCx_ = videoValid_ ? ovi.base_width : 0;
+	baseCy_ = videoValid_ ? ovi.base_height : 0;
+
+	// Tally is maintained from frontend events on the UI thread, so this
+	// takes no frontend locks on the graphics thread
+	TallyState *tally = GetTallyState();
+	studioMode_ = tally->studioMode();
+	previewScene_ = studioMode_ ? tally->previewSceneRef() : nullptr;
+
+	// A transition holds its destination in source B only while running
+	transitionActive_ = false;
+	obs_source_t *output = obs_get_output_source(0);
+	if (output && obs_source_get_type(output) == OBS_SOURCE_TYPE_TRANSITION) {
+		obs_source_t *next = obs_transition_get_source(output, OBS_TRANSITION_SOURCE_B);
+		transitionActive_ = next != nullptr;
+		obs_source_release(next);
+	}
+	obs_source_release(output);
+}
+
+bool RenderFrameContext::baseSize(uint32_t &cx, uint32_t &cy)
+{
+	build();
+	cx = baseCx_;
+	cy = baseCy_;
+	return videoValid_;
+}
+
+bool RenderFrameContext::canvas(const QByteArray &name, CanvasInfo &info)
+{
+	for (const CanvasInfo &cached : canvases_) {
+		if (cached.name == name) {
+			info = cached;
+			return info.canvas != nullptr;
+		}
+	}
+
+	// First request for this canvas this frame; negative results are
+	// cached too so a missing canvas costs one lookup per frame
+	CanvasInfo resolved;
+	resolved.name = name;
+	resolved.canvas = name.isEmpty() ? obs_get_main_canvas() : obs_get_canvas_by_name(name.constData());
+	if (resolved.canvas) {
+		struct obs_video_info ovi;
+		if (obs_canvas_get_video_info(resolved.canvas, &ovi)) {
+			resolved.cx = ovi.base_width;
+			resolved.cy = ovi.base_height;
+		}
+	}
+	canvases_.append(resolved);
+
+	info = resolved;
+	return info.canvas != nullptr;
+}
+
+bool RenderFrameContext::studioMode()
+{
+	build();
+	return studioMode_;
+}
+
+obs_source_t *RenderFrameContext::previewScene()
+{
+	build();
+	return previewScene_;
+}
+
+bool RenderFrameContext::transitionActive()
+{
+	build();
+	return transitionActive_;
+}
@@ -0,0 +1,88 @@
+/*
+OBS Looking Glass - Custom Dynamic Multiview Plugin
+Copyright (C) 2025
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#pragma once
+
+#include <obs.h>
+
+#include <QByteArray>
+#include <QVector>
+
+#include <atomic>
+#include <cstdint>
+
+/**
+ * Per-frame snapshot of OBS state shared by every CellRenderer in every
+ * multiview window. Built lazily by the first draw callback after each OBS
+ * video tick, so base resolution, canvas handles, the studio-mode flag and
+ * the preview scene reference are fetched once per frame (and once per
+ * distinct canvas) instead of once per cell per window. It also records
+ * whether a program transition is in progress, which decides whether the
+ * main texture currently equals the program scene.
+ *
+ * Accessors run on the OBS graphics thread. Returned handles are borrowed
+ * and stay valid until the next tick.
+ */
+class RenderFrameContext {
+public:
+	struct CanvasInfo {
+		QByteArray name;
+		obs_canvas_t *canvas = nullptr;
+		uint32_t cx = 0;
+		uint32_t cy = 0;
+	};
+
+	RenderFrameContext();
+	~RenderFrameContext();
+
+	// Monotonic frame index, advanced once per OBS video tick. Also read
+	// from the UI thread to tell when the graphics thread has moved on.
+	uint64_t frame() const { return frame_.load(std::memory_order_acquire); }
+
+	// Main canvas base resolution; false if video is not initialized
+	bool baseSize(uint32_t &cx, uint32_t &cy);
+
+	// Canvas by name (empty name = main canvas); false if not found
+	bool canvas(const QByteArray &name, CanvasInfo &info);
+
+	bool studioMode();
+
+	// Current studio-mode preview scene, or nullptr outside studio mode
+	obs_source_t *previewScene();
+
+	// True while the main output is mid-transition between two scenes
+	bool transitionActive();
+
+	// Drop all references held for the current frame
+	void clear();
+
+private:
+	static void TickCallback(void *data, float seconds);
+	void build();
+
+	std::atomic<uint64_t> frame_{0};
+	bool built_ = false;
+
+	bool videoValid_ = false;
+	uint32_t baseCx_ = 0;
+	uint32_t baseCy_ = 0;
+	bool studioMode_ = false;
+	bool transitionActive_ = false;
+	obs_source_t *previewScene_ = nullptr;
+	QVector<CanvasInfo> canvases_;
+};
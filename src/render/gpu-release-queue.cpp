@@ -0,0 +1,71 @@
+/*
+OBS Looking Glass - Custom Dynamic Multiview Plugin
+Copyright (C) 2025
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#include "gpu-release-queue.hpp"
+
+GpuReleaseQueue::GpuReleaseQueue() {}
+
+GpuReleaseQueue::~GpuReleaseQueue()
+{
+	// Normally empty: drained at frontend exit while video is still up
+	drain();
+}
+
+void GpuReleaseQueue::releaseTexrender(gs_texrender_t *texrender)
+{
+	if (texrender)
+		push(Kind::Texrender, texrender);
+}
+
+void GpuReleaseQueue::releaseVertexBuffer(gs_vertbuffer_t *vb)
+{
+	if (vb)
+		push(Kind::VertexBuffer, vb);
+}
+
+void GpuReleaseQueue::push(Kind kind, void *object)
+{
+	Node *node = new Node{kind, object, head_.load(std::memory_order_relaxed)};
+	while (!head_.compare_exchange_weak(node->next, node, std::memory_order_release, std::memory_order_relaxed)) {
+	}
+}
+
+void GpuReleaseQueue::drain()
+{
+	// Taking the whole list at once leaves nothing for another drain to
+	// race on; order of destruction does not matter
+	Node *node = head_.exchange(nullptr, std::memory_order_acquire);
+	if (!node)
+		return;
+
+	obs_enter_graphics();
+	while (node) {
+		switch (node->kind) {
+		case Kind::Texrender:
+			gs_texrender_destroy((gs_texrender_t *)node->object);
+			break;
+		case Kind::VertexBuffer:
+			gs_vertexbuffer_destroy((gs_vertbuffer_t *)node->object);
+			break;
+		}
+		Node *next = node->next;
+		delete node;
+		node = next;
+	}
+	obs_leave_graphics();
+}
@@ -0,0 +1,60 @@
+/*
+OBS Looking Glass - Custom Dynamic Multiview Plugin
+Copyright (C) 2025
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#pragma once
+
+#include <obs.h>
+#include <graphics/graphics.h>
+
+#include <atomic>
+
+/**
+ * Deferred destruction of GPU objects owned by UI-thread objects. Closing a
+ * window or switching scene collections releases every cell's render
+ * targets and vertex buffers; entering the graphics context for each one
+ * would contend with the render loop once per object. Instead they are
+ * pushed onto a lock-free list from any thread and destroyed in one batch
+ * by the graphics thread at its next video tick.
+ *
+ * Objects must no longer be drawn by any display when they are queued.
+ */
+class GpuReleaseQueue {
+public:
+	GpuReleaseQueue();
+	~GpuReleaseQueue();
+
+	void releaseTexrender(gs_texrender_t *texrender);
+	void releaseVertexBuffer(gs_vertbuffer_t *vb);
+
+	// Destroy everything queued so far; enters the graphics context itself,
+	// and only if something is queued
+	void drain();
+
+private:
+	enum class Kind { Texrender, VertexBuffer };
+
+	struct Node {
+		Kind kind;
+		void *object;
+		Node *next;
+	};
+
+	void push(Kind kind, void *object);
+
+	std::atomic<Node *> head_{nullptr};
+};
@@ -0,0 +1,237 @@
+/*
+OBS Looking Glass - Custom Dynamic Multiview Plugin
+Copyright (C) 2025
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#include "image-cache.hpp"
+#include "frame-context.hpp"
+#include "../plugin.hpp"
+
+#include <QImageReader>
+#include <QPainter>
+#include <QSvgRenderer>
+
+// Images are rasterized at the requested size rounded up to this step, so
+// small window resizes reuse the same texture
+#define SIZE_STEP 64
+#define MAX_SIZE 4096
+
+// Least recently used textures are released above this many bytes
+#define TEXTURE_BUDGET (128 * 1024 * 1024)
+
+ImageCache::ImageCache()
+{
+	// Decoding is rare and bursty (window open, layout change)
+	pool_.setMaxThreadCount(1);
+}
+
+ImageCache::~ImageCache()
+{
+	pool_.clear();
+	pool_.waitForDone();
+
+	// Normally already released by clear() at frontend exit
+	if (textureBytes_ > 0) {
+		obs_enter_graphics();
+		for (const Entry &entry : entries_)
+			gs_texture_destroy(entry.texture);
+		obs_leave_graphics();
+	}
+}
+
+int ImageCache::SizeBucket(int size)
+{
+	int bucket = ((qMax(size, 1) + SIZE_STEP - 1) / SIZE_STEP) * SIZE_STEP;
+	return qMin(bucket, MAX_SIZE);
+}
+
+// Runs on the worker thread
+QImage ImageCache::Decode(const QString &path, int bucket)
+{
+	if (path.endsWith(QStringLiteral(".svg"), Qt::CaseInsensitive)) {
+		QSvgRenderer svg(path);
+		if (!svg.isValid())
+			return QImage();
+
+		QSize size = svg.defaultSize();
+		if (size.isEmpty())
+			size = QSize(bucket, bucket);
+		size.scale(bucket, bucket, Qt::KeepAspectRatio);
+
+		QImage image(size, QImage::Format_RGBA8888_Premultiplied);
+		image.fill(Qt::transparent);
+		QPainter painter(&image);
+		painter.setRenderHint(QPainter::Antialiasing);
+		painter.setRenderHint(QPainter::SmoothPixmapTransform);
+		svg.render(&painter);
+		painter.end();
+		return image;
+	}
+
+	// Let the decoder scale large photos down while decoding
+	QImageReader reader(path);
+	reader.setAutoTransform(true);
+	QSize size = reader.size();
+	if (size.isValid() && (size.width() > bucket || size.height() > bucket)) {
+		size.scale(bucket, bucket, Qt::KeepAspectRatio);
+		reader.setScaledSize(size);
+	}
+
+	QImage image;
+	if (!reader.read(&image))
+		return QImage();
+	return image.convertToFormat(QImage::Format_RGBA8888_Premultiplied);
+}
+
+void ImageCache::clear()
+{
+	pool_.clear();
+
+	// Lookups run under the graphics lock, so holding it makes this safe
+	// against draw callbacks in flight
+	obs_enter_graphics();
+	for (const Entry &entry : entries_)
+		gs_texture_destroy(entry.texture);
+	entries_.clear();
+	textureBytes_ = 0;
+	frame_ = UINT64_MAX;
+	generation_++;
+	obs_leave_graphics();
+
+	std::lock_guard<std::mutex> lock(completedMutex_);
+	completed_.clear();
+}
+
+void ImageCache::beginFrame()
+{
+	uint64_t frame = GetRenderFrameContext()->frame();
+	if (frame == frame_)
+		return;
+	frame_ = frame;
+
+	QVector<Completed> completed;
+	{
+		std::lock_guard<std::mutex> lock(completedMutex_);
+		completed.swap(completed_);
+	}
+
+	for (const Completed &done : completed) {
+		if (done.generation != generation_)
+			continue;
+
+		auto it = entries_.find(EntryKey(done.path, done.bucket));
+		if (it == entries_.end() || !it->pending)
+			continue;
+
+		it->pending = false;
+		if (done.image.isNull()) {
+			obs_log(LOG_WARNING, "failed to load image: %s", done.path.toUtf8().constData());
+			it->failed = true;
+			continue;
+		}
+
+		const uint8_t *bits = done.image.constBits();
+		it->texture = gs_texture_create((uint32_t)done.image.width(), (uint32_t)done.image.height(), GS_RGBA, 1,
+						&bits, 0);
+		it->failed = !it->texture;
+		if (it->texture) {
+			it->id = nextId_++;
+			it->cx = (uint32_t)done.image.width();
+			it->cy = (uint32_t)done.image.height();
+			textureBytes_ += (size_t)it->cx * it->cy * 4;
+		}
+	}
+
+	if (textureBytes_ > TEXTURE_BUDGET)
+		evict();
+}
+
+// Release least recently used textures until the cache fits its budget.
+// This runs at the start of a frame, before any lookups, so textures used
+// in the previous frame are kept: cells on screen look theirs up every
+// frame and would otherwise have them decoded again and again.
+void ImageCache::evict()
+{
+	while (textureBytes_ > TEXTURE_BUDGET) {
+		auto oldest = entries_.end();
+		for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+			if (!it->texture || it->lastUsed + 1 >= frame_)
+				continue;
+			if (oldest == entries_.end() || it->lastUsed < oldest->lastUsed)
+				oldest = it;
+		}
+		if (oldest == entries_.end())
+			break;
+
+		gs_texture_destroy(oldest->texture);
+		textureBytes_ -= (size_t)oldest->cx * oldest->cy * 4;
+		entries_.erase(oldest);
+	}
+}
+
+ImageCache::Status ImageCache::lookup(const QString &path, int size, Image &image)
+{
+	beginFrame();
+
+	image = Image();
+	int bucket = SizeBucket(size);
+	EntryKey key(path, bucket);
+	auto it = entries_.find(key);
+	if (it == entries_.end()) {
+		it = entries_.insert(key, Entry());
+
+		int generation = generation_;
+		pool_.start([this, path, bucket, generation]() {
+			Completed done;
+			done.path = path;
+			done.bucket = bucket;
+			done.generation = generation;
+			done.image = Decode(path, bucket);
+
+			std::lock_guard<std::mutex> lock(completedMutex_);
+			completed_.append(done);
+		});
+	}
+
+	it->lastUsed = frame_;
+	if (it->failed)
+		return Status::Failed;
+
+	if (it->texture) {
+		image.texture = it->texture;
+		image.cx = it->cx;
+		image.cy = it->cy;
+		image.id = it->id;
+		return Status::Ready;
+	}
+
+	// Show the closest size already rasterized until this one is ready
+	int bestDistance = INT32_MAX;
+	for (auto other = entries_.begin(); other != entries_.end(); ++other) {
+		if (!other->texture || other.key().first != path)
+			continue;
+		int distance = qAbs(other.key().second - bucket);
+		if (distance < bestDistance) {
+			bestDistance = distance;
+			image.texture = other->texture;
+			image.cx = other->cx;
+			image.cy = other->cy;
+			image.id = other->id;
+			other->lastUsed = frame_;
+		}
+	}
+	return Status::Pending;
+}
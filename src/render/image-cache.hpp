@@ -0,0 +1,107 @@
+/*
+OBS Looking Glass - Custom Dynamic Multiview Plugin
+Copyright (C) 2025
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#pragma once
+
+#include <obs.h>
+#include <graphics/graphics.h>
+
+#include <QHash>
+#include <QImage>
+#include <QPair>
+#include <QString>
+#include <QThreadPool>
+#include <QVector>
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+/**
+ * Process-wide cache of placeholder icons and still images (SVG, PNG, JPEG)
+ * shared by every cell in every multiview window. Images are keyed by path
+ * and size bucket, decoded and rasterized on a worker thread and uploaded
+ * once as static textures, so cells showing the same image at similar sizes
+ * share one texture and resizing a window never parses files on the
+ * graphics thread.
+ *
+ * Lookups run on the OBS graphics thread. Textures that have not been used
+ * recently are released once the cache grows past its memory budget.
+ */
+class ImageCache {
+public:
+	enum class Status {
+		Ready,   // Raster for the requested size
+		Pending, // Being decoded; image may hold a raster of another size
+		Failed,  // File missing or not a supported image
+	};
+
+	struct Image {
+		gs_texture_t *texture = nullptr;
+		uint32_t cx = 0;
+		uint32_t cy = 0;
+		uint64_t id = 0; // Never reused, unlike texture pointers
+	};
+
+	ImageCache();
+	~ImageCache();
+
+	// Image at path rasterized to fit a size x size square
+	Status lookup(const QString &path, int size, Image &image);
+
+	// Release all textures and forget all images
+	void clear();
+
+private:
+	struct Entry {
+		gs_texture_t *texture = nullptr;
+		uint32_t cx = 0;
+		uint32_t cy = 0;
+		bool pending = true;
+		bool failed = false;
+		uint64_t id = 0;
+		uint64_t lastUsed = 0; // Frame of the last lookup
+	};
+
+	struct Completed {
+		QString path;
+		int bucket = 0;
+		int generation = 0;
+		QImage image;
+	};
+
+	using EntryKey = QPair<QString, int>;
+
+	void beginFrame();
+	void evict();
+	static int SizeBucket(int size);
+	static QImage Decode(const QString &path, int bucket);
+
+	// Graphics thread state
+	QHash<EntryKey, Entry> entries_;
+	size_t textureBytes_ = 0;
+	uint64_t frame_ = UINT64_MAX;
+	uint64_t nextId_ = 1;
+
+	// Decoded images handed back from the worker
+	std::mutex completedMutex_;
+	QVector<Completed> completed_;
+	std::atomic<int> generation_{0};
+
+	QThreadPool pool_;
+};
@@ -0,0 +1,384 @@
+/*
+OBS Looking Glass - Custom Dynamic Multiview Plugin
+Copyright (C) 2025
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#include "label-atlas.hpp"
+#include "frame-context.hpp"
+#include "../plugin.hpp"
+
+#include <QFontMetrics>
+#include <QPainter>
+
+#include <cstring>
+
+// Atlas width is fixed; height starts small and doubles up to the maximum,
+// after which labels no longer on screen are repacked out
+#define ATLAS_WIDTH 1024
+#define ATLAS_INITIAL_HEIGHT 256
+#define ATLAS_MAX_HEIGHT 2048
+
+// Transparent border around each label so linear filtering never samples
+// a neighbouring entry
+#define GLYPH_PADDING 2
+
+// Point size used when the cell has no font configured
+#define DEFAULT_LABEL_SIZE 36
+
+LabelAtlas::LabelAtlas()
+{
+	// One worker is plenty; labels only change on config edits
+	pool_.setMaxThreadCount(1);
+}
+
+LabelAtlas::~LabelAtlas()
+{
+	pool_.clear();
+	pool_.waitForDone();
+
+	// Normally already released by clear() at frontend exit
+	if (texture_) {
+		obs_enter_graphics();
+		gs_texture_destroy(texture_);
+		obs_leave_graphics();
+	}
+}
+
+QFont LabelAtlas::LabelFont(const QString &fontDesc)
+{
+	QFont font;
+	if (!fontDesc.isEmpty())
+		font.fromString(fontDesc);
+	int size = font.pointSize() > 0 ? font.pointSize() : DEFAULT_LABEL_SIZE;
+	font.setPixelSize(size);
+	return font;
+}
+
+void LabelAtlas::Measure(const QFont &font, const QString &text, uint32_t &cx, uint32_t &cy)
+{
+	QFontMetrics metrics(font);
+	cx = (uint32_t)(metrics.horizontalAdvance(text) + 2 * GLYPH_PADDING);
+	cy = (uint32_t)(metrics.height() + 2 * GLYPH_PADDING);
+}
+
+QString LabelAtlas::MakeKey(const QString &fontDesc, const QString &text)
+{
+	// Font descriptions never contain a newline, so the first one splits
+	return fontDesc + QLatin1Char('\n') + text;
+}
+
+// Runs on the worker thread
+QImage LabelAtlas::Rasterize(const QString &key, int pixelHeight)
+{
+	int split = key.indexOf(QLatin1Char('\n'));
+	QFont font = LabelFont(key.left(split));
+	QString text = key.mid(split + 1);
+
+	// Scale the font so its padded line height matches the requested
+	// height, then shrink further if the label would not fit the atlas
+	uint32_t nativeW, nativeH;
+	Measure(font, text, nativeW, nativeH);
+	double scale = (double)pixelHeight / (double)nativeH;
+	if (nativeW * scale > ATLAS_WIDTH)
+		scale = (double)ATLAS_WIDTH / (double)nativeW;
+	font.setPixelSize(qMax(1, qRound(font.pixelSize() * scale)));
+
+	uint32_t w, h;
+	Measure(font, text, w, h);
+	w = qMin(w, (uint32_t)ATLAS_WIDTH);
+
+	QImage image((int)w, (int)h, QImage::Format_RGBA8888_Premultiplied);
+	image.fill(Qt::transparent);
+
+	QPainter painter(&image);
+	painter.setRenderHint(QPainter::TextAntialiasing);
+	painter.setFont(font);
+	painter.setPen(Qt::white);
+	painter.drawText(QRect(GLYPH_PADDING, GLYPH_PADDING, (int)w - 2 * GLYPH_PADDING, (int)h - 2 * GLYPH_PADDING),
+			 Qt::AlignLeft | Qt::AlignVCenter | Qt::TextSingleLine, text);
+	painter.end();
+
+	return image;
+}
+
+void LabelAtlas::clear()
+{
+	pool_.clear();
+
+	// Lookups run under the graphics lock, so holding it makes this safe
+	// against draw callbacks in flight
+	obs_enter_graphics();
+	if (texture_) {
+		gs_texture_destroy(texture_);
+		texture_ = nullptr;
+	}
+	entries_.clear();
+	atlasImage_ = QImage();
+	shelfX_ = 0;
+	shelfY_ = 0;
+	shelfH_ = 0;
+	dirtyRect_ = QRect();
+	unplaced_.clear();
+	frame_ = UINT64_MAX;
+	generation_++;
+	obs_leave_graphics();
+
+	std::lock_guard<std::mutex> lock(completedMutex_);
+	completed_.clear();
+}
+
+bool LabelAtlas::grow()
+{
+	if (atlasImage_.height() >= ATLAS_MAX_HEIGHT)
+		return false;
+
+	QImage grown(ATLAS_WIDTH, atlasImage_.height() * 2, QImage::Format_RGBA8888_Premultiplied);
+	grown.fill(Qt::transparent);
+	for (int row = 0; row < atlasImage_.height(); row++)
+		memcpy(grown.scanLine(row), atlasImage_.constScanLine(row), (size_t)atlasImage_.bytesPerLine());
+	atlasImage_ = grown;
+
+	// The texture is recreated at the new size on upload
+	if (texture_) {
+		gs_texture_destroy(texture_);
+		texture_ = nullptr;
+	}
+	dirtyRect_ = atlasImage_.rect();
+	return true;
+}
+
+// Repack the labels looked up in the last frame into a fresh atlas and drop
+// the rest. Returns false, leaving the atlas untouched, if all of them are
+// still in use.
+bool LabelAtlas::compact()
+{
+	bool unused = false;
+	for (const Entry &entry : entries_) {
+		if (entry.ready && entry.lastUsed + 1 < frame_) {
+			unused = true;
+			break;
+		}
+	}
+	if (!unused)
+		return false;
+
+	QImage old = atlasImage_;
+	QHash<EntryKey, Entry> oldEntries = entries_;
+
+	atlasImage_ = QImage(ATLAS_WIDTH, ATLAS_INITIAL_HEIGHT, QImage::Format_RGBA8888_Premultiplied);
+	atlasImage_.fill(Qt::transparent);
+	entries_.clear();
+	shelfX_ = 0;
+	shelfY_ = 0;
+	shelfH_ = 0;
+	if (texture_) {
+		gs_texture_destroy(texture_);
+		texture_ = nullptr;
+	}
+	dirtyRect_ = atlasImage_.rect();
+
+	bool freed = false;
+	for (auto it = oldEntries.begin(); it != oldEntries.end(); ++it) {
+		Entry entry = it.value();
+		// Pending entries keep waiting for their raster
+		if (!entry.ready) {
+			entries_.insert(it.key(), entry);
+			continue;
+		}
+
+		int x, y;
+		if (entry.lastUsed + 1 < frame_ || !place(entry.w, entry.h, x, y)) {
+			freed = true;
+			continue;
+		}
+
+		for (int row = 0; row < entry.h; row++)
+			memcpy(atlasImage_.scanLine(y + row) + x * 4, old.constScanLine(entry.y + row) + entry.x * 4,
+			       (size_t)entry.w * 4);
+		entry.x = x;
+		entry.y = y;
+		entries_.insert(it.key(), entry);
+	}
+	return freed;
+}
+
+// Shelf packing: labels fill rows left to right; a label that does not fit
+// the current row opens a new row below the tallest label in it
+bool LabelAtlas::place(int w, int h, int &x, int &y)
+{
+	if (w > ATLAS_WIDTH)
+		return false;
+
+	if (shelfX_ + w > ATLAS_WIDTH) {
+		shelfY_ += shelfH_;
+		shelfX_ = 0;
+		shelfH_ = 0;
+	}
+	while (shelfY_ + h > atlasImage_.height()) {
+		if (!grow())
+			return false;
+	}
+
+	x = shelfX_;
+	y = shelfY_;
+	shelfX_ += w;
+	shelfH_ = qMax(shelfH_, h);
+	return true;
+}
+
+void LabelAtlas::beginFrame()
+{
+	uint64_t frame = GetRenderFrameContext()->frame();
+	if (frame == frame_)
+		return;
+	frame_ = frame;
+
+	if (atlasImage_.isNull()) {
+		atlasImage_ = QImage(ATLAS_WIDTH, ATLAS_INITIAL_HEIGHT, QImage::Format_RGBA8888_Premultiplied);
+		atlasImage_.fill(Qt::transparent);
+	}
+
+	// Labels that did not fit last time come first
+	QVector<Completed> completed;
+	completed.swap(unplaced_);
+	{
+		std::lock_guard<std::mutex> lock(completedMutex_);
+		completed += completed_;
+		completed_.clear();
+	}
+
+	bool compacted = false;
+	for (const Completed &done : completed) {
+		// Requested before the last clear; its entry no longer exists
+		if (done.generation != generation_)
+			continue;
+
+		auto it = entries_.find(EntryKey(done.key, done.pixelHeight));
+		if (it == entries_.end() || it->ready || done.image.isNull())
+			continue;
+
+		// No longer on screen; requested again if it comes back
+		if (it->lastUsed + 1 < frame_) {
+			entries_.erase(it);
+			continue;
+		}
+
+		int x, y;
+		bool placed = place(done.image.width(), done.image.height(), x, y);
+		if (!placed && !compacted) {
+			// At most one repack per frame; it uploads the whole atlas
+			compacted = true;
+			if (compact()) {
+				placed = place(done.image.width(), done.image.height(), x, y);
+				it = entries_.find(EntryKey(done.key, done.pixelHeight)); // Rebuilt by compact()
+			}
+		}
+		if (!placed) {
+			// Full of labels that are all on screen. The others stay
+			// where they are; this one waits until labels leave the
+			// screen and a repack frees room.
+			unplaced_.append(done);
+			continue;
+		}
+
+		for (int row = 0; row < done.image.height(); row++)
+			memcpy(atlasImage_.scanLine(y + row) + x * 4, done.image.constScanLine(row),
+			       (size_t)done.image.width() * 4);
+
+		it->ready = true;
+		it->x = x;
+		it->y = y;
+		it->w = done.image.width();
+		it->h = done.image.height();
+		dirtyRect_ |= QRect(x, y, it->w, it->h);
+	}
+
+	upload();
+}
+
+// Sends the changed part of the atlas to the GPU. New labels only touch
+// their own rectangles, so a clock ticking over uploads a few kilobytes
+// rather than the whole atlas. The region goes through a small staging
+// texture and a GPU copy: mapping the atlas would discard its contents on
+// Direct3D, so every map would have to rewrite all of it.
+void LabelAtlas::upload()
+{
+	if (dirtyRect_.isEmpty())
+		return;
+
+	if (!texture_) {
+		const uint8_t *bits = atlasImage_.constBits();
+		texture_ = gs_texture_create(ATLAS_WIDTH, (uint32_t)atlasImage_.height(), GS_RGBA, 1, &bits, 0);
+		dirtyRect_ = QRect();
+		return;
+	}
+
+	QImage region = atlasImage_.copy(dirtyRect_);
+	const uint8_t *bits = region.constBits();
+	gs_texture_t *staging =
+		gs_texture_create((uint32_t)region.width(), (uint32_t)region.height(), GS_RGBA, 1, &bits, 0);
+	if (staging) {
+		gs_copy_texture_region(texture_, (uint32_t)dirtyRect_.x(), (uint32_t)dirtyRect_.y(), staging, 0, 0,
+				       (uint32_t)region.width(), (uint32_t)region.height());
+		gs_texture_destroy(staging);
+		dirtyRect_ = QRect();
+	} else {
+		// Recreate the texture from the whole atlas next frame
+		gs_texture_destroy(texture_);
+		texture_ = nullptr;
+		dirtyRect_ = atlasImage_.rect();
+	}
+}
+
+bool LabelAtlas::lookup(const QString &key, int pixelHeight, Glyph &glyph)
+{
+	beginFrame();
+
+	EntryKey entryKey(key, pixelHeight);
+	auto it = entries_.find(entryKey);
+	if (it == entries_.end()) {
+		Entry entry;
+		entry.lastUsed = frame_;
+		entries_.insert(entryKey, entry);
+
+		int generation = generation_;
+		pool_.start([this, key, pixelHeight, generation]() {
+			Completed done;
+			done.key = key;
+			done.pixelHeight = pixelHeight;
+			done.generation = generation;
+			done.image = Rasterize(key, pixelHeight);
+
+			std::lock_guard<std::mutex> lock(completedMutex_);
+			completed_.append(done);
+		});
+		return false;
+	}
+
+	it->lastUsed = frame_;
+	if (!it->ready || !texture_)
+		return false;
+
+	float atlasH = (float)atlasImage_.height();
+	glyph.texture = texture_;
+	glyph.u0 = (float)it->x / (float)ATLAS_WIDTH;
+	glyph.v0 = (float)it->y / atlasH;
+	glyph.u1 = (float)(it->x + it->w) / (float)ATLAS_WIDTH;
+	glyph.v1 = (float)(it->y + it->h) / atlasH;
+	glyph.cx = (uint32_t)it->w;
+	glyph.cy = (uint32_t)it->h;
+	return true;
+}
@@ -0,0 +1,123 @@
+/*
+OBS Looking Glass - Custom Dynamic Multiview Plugin
+Copyright (C) 2025
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#pragma once
+
+#include <obs.h>
+#include <graphics/graphics.h>
+
+#include <QFont>
+#include <QHash>
+#include <QPair>
+#include <QRect>
+#include <QImage>
+#include <QString>
+#include <QThreadPool>
+#include <QVector>
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+/**
+ * Process-wide label text renderer shared by every cell in every multiview
+ * window. Each distinct (font, text, pixel height) is rasterized once with
+ * QPainter on a worker thread and packed into a single GPU atlas texture;
+ * cells showing the same label at the same size share one atlas slot, and
+ * labels are drawn as textured quads in the display's overlay pass.
+ *
+ * Lookups run on the OBS graphics thread. A label that has not been
+ * rasterized yet is queued and reported as not ready; finished rasters are
+ * packed and uploaded at the start of the next frame, so atlas coordinates
+ * handed out during a frame stay valid until it ends. Labels that change
+ * often, such as clocks, leave unused entries behind; when the atlas is
+ * full only the entries still being drawn are kept. Only the rectangles
+ * that changed are uploaded.
+ */
+class LabelAtlas {
+public:
+	struct Glyph {
+		gs_texture_t *texture = nullptr;
+		float u0 = 0.0f, v0 = 0.0f, u1 = 0.0f, v1 = 0.0f;
+		uint32_t cx = 0; // Raster size in pixels
+		uint32_t cy = 0;
+	};
+
+	LabelAtlas();
+	~LabelAtlas();
+
+	// Font used for a label: the cell's configured font at its point size
+	// taken as pixels, matching how the OBS text sources sized labels
+	static QFont LabelFont(const QString &fontDesc);
+
+	// Native label size for text in font, padding included
+	static void Measure(const QFont &font, const QString &text, uint32_t &cx, uint32_t &cy);
+
+	// Atlas entry for key (font description and text, see MakeKey) drawn
+	// at pixelHeight. Returns false and queues rasterization if not ready.
+	bool lookup(const QString &key, int pixelHeight, Glyph &glyph);
+
+	static QString MakeKey(const QString &fontDesc, const QString &text);
+
+	// Destroy the atlas texture and forget all labels
+	void clear();
+
+private:
+	struct Entry {
+		bool ready = false;
+		int x = 0;
+		int y = 0;
+		int w = 0;
+		int h = 0;
+		uint64_t lastUsed = 0; // Frame of the last lookup
+	};
+
+	struct Completed {
+		QString key;
+		int pixelHeight = 0;
+		int generation = 0;
+		QImage image;
+	};
+
+	using EntryKey = QPair<QString, int>;
+
+	void beginFrame();
+	bool place(int w, int h, int &x, int &y);
+	bool grow();
+	bool compact();
+	void upload();
+	static QImage Rasterize(const QString &key, int pixelHeight);
+
+	// Graphics thread state
+	QHash<EntryKey, Entry> entries_;
+	QImage atlasImage_; // CPU copy of the texture
+	gs_texture_t *texture_ = nullptr;
+	QRect dirtyRect_;             // Part of the CPU copy not uploaded yet
+	QVector<Completed> unplaced_; // Rasters waiting for room in the atlas
+	int shelfX_ = 0;
+	int shelfY_ = 0;
+	int shelfH_ = 0;
+	uint64_t frame_ = UINT64_MAX;
+
+	// Rasterization results handed back from the worker
+	std::mutex completedMutex_;
+	QVector<Completed> completed_;
+	std::atomic<int> generation_{0};
+
+	QThreadPool pool_;
+};
@@ -0,0 +1,172 @@
+/*
+OBS Looking Glass - Custom Dynamic Multiview Plugin
+Copyright (C) 2025
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#include "multiview-compositor.hpp"
+#include "multiview-renderer.hpp"
+#include "frame-context.hpp"
+#include "../plugin.hpp"
+
+#include <graphics/graphics.h>
+
+MultiviewCompositor::MultiviewCompositor() {}
+
+MultiviewCompositor::~MultiviewCompositor()
+{
+	cleanup();
+}
+
+void MultiviewCompositor::init(QWidget *surface)
+{
+	cleanup();
+
+	if (!surface)
+		return;
+
+	display_ = CreateSurfaceDisplay(surface);
+	if (display_) {
+		displayW_ = (uint32_t)surface->width();
+		displayH_ = (uint32_t)surface->height();
+		obs_display_add_draw_callback(display_, DrawCallback, this);
+		obs_display_set_enabled(display_, enabled_);
+	}
+}
+
+void MultiviewCompositor::cleanup()
+{
+	if (display_) {
+		obs_display_remove_draw_callback(display_, DrawCallback, this);
+		obs_display_destroy(display_);
+		display_ = nullptr;
+	}
+	overlays_.destroy();
+	// With the display gone no draw can still hold a snapshot
+	reclaimAll();
+}
+
+void MultiviewCompositor::resize(uint32_t width, uint32_t height)
+{
+	// Same-size resizes would still rebuild the swap chain
+	if (display_ && (width != displayW_ || height != displayH_)) {
+		obs_display_resize(display_, width, height);
+		displayW_ = width;
+		displayH_ = height;
+	}
+}
+
+void MultiviewCompositor::setEnabled(bool enabled)
+{
+	enabled_ = enabled;
+	if (display_)
+		obs_display_set_enabled(display_, enabled);
+}
+
+void MultiviewCompositor::setLayout(const QVector<CellSlot> &cells, const QVector<QRect> &gridLines,
+				    const QColor &lineColor)
+{
+	auto *layout = new Layout;
+	layout->cells = cells;
+	layout->gridLines = gridLines;
+	// Overlay colors are 0xAARRGGBB
+	layout->lineColor = (uint32_t)lineColor.rgba();
+	publishLayout(layout);
+}
+
+void MultiviewCompositor::clearLayout()
+{
+	publishLayout(nullptr);
+}
+
+void MultiviewCompositor::publishLayout(const Layout *layout)
+{
+	reclaim();
+	const Layout *old = layout_.exchange(layout, std::memory_order_acq_rel);
+	if (old)
+		retired_.append({old, GetRenderFrameContext()->frame()});
+}
+
+void MultiviewCompositor::retireRenderers(const QVector<CellRenderer *> &renderers)
+{
+	uint64_t frame = GetRenderFrameContext()->frame();
+	for (CellRenderer *r : renderers)
+		retiredRenderers_.append({r, frame});
+}
+
+bool MultiviewCompositor::reclaim()
+{
+	// A draw started before a replacement finishes within the frame it
+	// began in, so anything retired two frames ago is unreachable
+	uint64_t frame = GetRenderFrameContext()->frame();
+	for (int i = 0; i < retired_.size();) {
+		if (frame >= retired_[i].frame + 2) {
+			delete retired_[i].layout;
+			retired_.removeAt(i);
+		} else {
+			i++;
+		}
+	}
+	for (int i = 0; i < retiredRenderers_.size();) {
+		if (frame >= retiredRenderers_[i].frame + 2) {
+			delete retiredRenderers_[i].renderer;
+			retiredRenderers_.removeAt(i);
+		} else {
+			i++;
+		}
+	}
+	return !retired_.isEmpty() || !retiredRenderers_.isEmpty();
+}
+
+void MultiviewCompositor::reclaimAll()
+{
+	delete layout_.exchange(nullptr);
+	for (const RetiredLayout &r : retired_)
+		delete r.layout;
+	retired_.clear();
+	for (const RetiredRenderer &r : retiredRenderers_)
+		delete r.renderer;
+	retiredRenderers_.clear();
+}
+
+void MultiviewCompositor::DrawCallback(void *data, uint32_t cx, uint32_t cy)
+{
+	auto *self = (MultiviewCompositor *)data;
+	self->render(cx, cy);
+}
+
+void MultiviewCompositor::render(uint32_t cx, uint32_t cy)
+{
+	if (cx == 0 || cy == 0)
+		return;
+
+	const Layout *layout = layout_.load(std::memory_order_acquire);
+	if (!layout)
+		return;
+
+	for (const CellSlot &slot : layout->cells) {
+		if (!slot.renderer || slot.rect.width() <= 0 || slot.rect.height() <= 0)
+			continue;
+		slot.renderer->renderComposited(slot.rect.x(), slot.rect.y(), (uint32_t)slot.rect.width(),
+						(uint32_t)slot.rect.height(), overlays_);
+	}
+
+	// Grid lines join the cell overlays in window space, matching the gaps
+	// the per-cell surfaces leave for the QPainter lines in the default mode
+	for (const QRect &line : layout->gridLines)
+		overlays_.addRect((float)line.x(), (float)line.y(), (float)line.width(), (float)line.height(),
+				  layout->lineColor);
+	overlays_.flush(cx, cy);
+}
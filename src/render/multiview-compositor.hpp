@@ -0,0 +1,101 @@
+/*
+OBS Looking Glass - Custom Dynamic Multiview Plugin
+Copyright (C) 2025
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#pragma once
+
+#include "overlay-batcher.hpp"
+
+#include <obs.h>
+
+#include <QColor>
+#include <QRect>
+#include <QVector>
+#include <QWidget>
+
+#include <atomic>
+#include <cstdint>
+
+class CellRenderer;
+
+/**
+ * Draws an entire multiview window through a single obs_display_t.
+ * Every cell is rendered into its own viewport of the shared swap chain and
+ * the grid lines are drawn on the GPU, so a window costs one present per
+ * frame regardless of how many cells it contains. Overlays and labels from
+ * every cell and the grid lines share one overlay pass.
+ */
+class MultiviewCompositor {
+public:
+	// A renderer and the window-space rectangle it occupies
+	struct CellSlot {
+		CellRenderer *renderer = nullptr;
+		QRect rect;
+	};
+
+	MultiviewCompositor();
+	~MultiviewCompositor();
+
+	void init(QWidget *surface);
+	void cleanup();
+	void resize(uint32_t width, uint32_t height);
+	void setEnabled(bool enabled);
+
+	// Replace the cell placement and grid line geometry (UI thread)
+	void setLayout(const QVector<CellSlot> &cells, const QVector<QRect> &gridLines, const QColor &lineColor);
+	void clearLayout();
+
+	// Take ownership of renderers dropped from the layout. A draw may still
+	// hold a layout that names them, so they are deleted two frames later.
+	void retireRenderers(const QVector<CellRenderer *> &renderers);
+	// Free retired layouts and renderers no draw can still reach. Returns
+	// true while some remain (UI thread).
+	bool reclaim();
+
+private:
+	// Immutable layout snapshot read by the graphics thread
+	struct Layout {
+		QVector<CellSlot> cells;
+		QVector<QRect> gridLines;
+		uint32_t lineColor = 0xFFFFFFFF;
+	};
+	struct RetiredLayout {
+		const Layout *layout;
+		uint64_t frame;
+	};
+	struct RetiredRenderer {
+		CellRenderer *renderer;
+		uint64_t frame;
+	};
+
+	void publishLayout(const Layout *layout);
+	void reclaimAll();
+
+	static void DrawCallback(void *data, uint32_t cx, uint32_t cy);
+	void render(uint32_t cx, uint32_t cy);
+
+	obs_display_t *display_ = nullptr;
+	uint32_t displayW_ = 0;
+	uint32_t displayH_ = 0;
+	bool enabled_ = true;
+	OverlayBatcher overlays_; // Graphics thread only
+
+	// Published with release ordering; the draw loads it once per frame
+	std::atomic<const Layout *> layout_{nullptr};
+	QVector<RetiredLayout> retired_;            // Replaced snapshots not yet freed (UI thread)
+	QVector<RetiredRenderer> retiredRenderers_; // Removed renderers not yet freed (UI thread)
+};
@@ -17,18 +17,22 @@ with this program. If not, see <https://www.gnu.org/licenses/>
 */
 
 #include "multiview-renderer.hpp"
+#include "source-texture-cache.hpp"
+#include "frame-context.hpp"
+#include "render-governor.hpp"
+#include "label-atlas.hpp"
+#include "image-cache.hpp"
+#include "gpu-release-queue.hpp"
 #include "../plugin.hpp"
+#include "../core/tally-state.hpp"
+#include "../core/label-tokens.hpp"
 
 #include <obs-frontend-api.h>
-#include <graphics/matrix4.h>
 #include <graphics/vec4.h>
+#include <util/platform.h>
 
 #include <QFont>
-#include <QFontDatabase>
-#include <QImage>
-#include <QPainter>
-#include <QPainterPath>
-#include <QSvgRenderer>
+#include <QTimer>
 
 #include <cmath>
 
@@ -69,7 +73,32 @@ static void GetScaleAndCenterPos(int baseCX, int baseCY, int windowCX, int windo
 	y = remainderY / 2;
 }
 
-CellRenderer::CellRenderer() {}
+obs_display_t *CreateSurfaceDisplay(QWidget *surface)
+{
+	gs_init_data initData = {};
+	initData.cx = surface->width();
+	initData.cy = surface->height();
+	initData.format = GS_BGRA;
+
+#ifdef _WIN32
+	initData.window.hwnd = (HWND)surface->winId();
+#elif defined(__APPLE__)
+	initData.window.view = (id)surface->winId();
+#else
+	initData.window.id = surface->winId();
+	initData.window.display = nullptr; // X11/Wayland
+#endif
+
+	obs_display_t *display = obs_display_create(&initData, 0);
+	if (display)
+		obs_display_set_background_color(display, 0x000000);
+	return display;
+}
+
+CellRenderer::CellRenderer()
+{
+	governorPhase_ = GetRenderGovernor()->nextPhase();
+}
 
 CellRenderer::~CellRenderer()
 {
@@ -86,33 +115,33 @@ void CellRenderer::init(QWidget *surface, const CellConfig &config)
 	if (!surface_)
 		return;
 
+	// Published before the display exists, so its first draw has a state
+	applyConfig();
+
 	// Skip display creation for None widgets to avoid unnecessary
 	// swap chain overhead. Each obs_display_t adds rendering cost
 	// even when the draw callback exits early.
 	if (config.widget.type == WidgetType::None)
 		return;
 
-	gs_init_data initData = {};
-	initData.cx = surface_->width();
-	initData.cy = surface_->height();
-	initData.format = GS_BGRA;
-
-#ifdef _WIN32
-	initData.window.hwnd = (HWND)surface_->winId();
-#elif defined(__APPLE__)
-	initData.window.view = (id)surface_->winId();
-#else
-	initData.window.id = surface_->winId();
-	initData.window.display = nullptr; // X11/Wayland
-#endif
-
-	display_ = obs_display_create(&initData, 0);
+	display_ = CreateSurfaceDisplay(surface_);
 	if (display_) {
+		displayW_ = (uint32_t)surface_->width();
+		displayH_ = (uint32_t)surface_->height();
 		obs_display_add_draw_callback(display_, DrawCallback, this);
-		obs_display_set_background_color(display_, 0x000000);
+		obs_display_set_enabled(display_, displayEnabled());
 	}
+}
+
+void CellRenderer::initComposited(const CellConfig &config)
+{
+	cleanup();
+
+	config_ = config;
 
-	createLabelSource();
+	// No display of its own: the owning MultiviewCompositor calls
+	// renderComposited() for this cell from its single draw callback.
+	applyConfig();
 }
 
 void CellRenderer::cleanup()
@@ -122,78 +151,451 @@ void CellRenderer::cleanup()
 		obs_display_destroy(display_);
 		display_ = nullptr;
 	}
-	destroyLabelSource();
-	destroyLabelBgTexture();
-	destroyPlaceholderTexture();
-	destroySafeAreaGeometry();
+
+	// Composited cells are only freed once no compositor draw can reach
+	// them, so no draw can still be reading the published state
+	delete state_.exchange(nullptr);
+	reclaimStates(true);
+	drawState_ = nullptr;
+	appliedGeneration_ = 0;
+
+	label_ = LabelText();
+	labelPrev_ = LabelText();
+	labelExpanded_.clear();
+	labelFontDesc_.clear();
+	destroyHoldTexture();
+	overlay_.destroy();
+	releaseShowing();
+	obs_weak_source_release(lastGoodSource_);
+	lastGoodSource_ = nullptr;
+	contentSource_.reset();
+	tokenSource_.reset();
 	surface_ = nullptr;
 }
 
 void CellRenderer::updateConfig(const CellConfig &config)
 {
+	// None cells are created without a display; one is added when such a
+	// cell gets content. A cell switched to None keeps its display, only
+	// disabled, so switching back does not rebuild the swap chain.
+	if (surface_ && !display_ && config.widget.type != WidgetType::None) {
+		init(surface_, config);
+		return;
+	}
+
+	bool hadContent = config_.widget.type != WidgetType::None;
 	config_ = config;
-	updateLabelSource();
+	if (display_ && hadContent && config_.widget.type == WidgetType::None) {
+		// Let the display present a cleared frame before it stops, or the
+		// surface would keep showing the old content
+		QTimer::singleShot(100, surface_, [this]() {
+			if (display_)
+				obs_display_set_enabled(display_, displayEnabled());
+		});
+	} else if (display_) {
+		obs_display_set_enabled(display_, displayEnabled());
+	}
+	applyConfig();
+}
+
+void CellRenderer::applyConfig()
+{
+	configGeneration_++;
+	updateContentSource();
+	updateShowing();
+	updateLabel();
+	publishState();
+}
+
+bool CellRenderer::displayEnabled() const
+{
+	return visible_ && config_.widget.type != WidgetType::None;
+}
+
+// Name of the scene or source shown by Scene/Source cells
+static QString ContentName(const WidgetConfig &widget)
+{
+	switch (widget.type) {
+	case WidgetType::Scene:
+		return widget.sceneName;
+	case WidgetType::Source:
+		return widget.sourceName;
+	default:
+		return QString();
+	}
+}
+
+// The graphics thread keeps its own reference, renamed when it picks up a
+// new state; this one only feeds label tokens on the UI thread
+void CellRenderer::updateContentSource()
+{
+	tokenSource_.setName(ContentName(config_.widget));
+}
+
+// --- Render state publication ---
+
+// Snapshots are immutable once published. The draw callback loads the
+// current pointer once per draw, so a snapshot replaced by the UI thread is
+// only freed after the graphics thread has started two newer frames, by
+// which point no draw can still hold it.
+void CellRenderer::publishState()
+{
+	auto *state = new RenderState;
+	state->widget = config_.widget;
+	state->canvasName = config_.widget.canvasName.toUtf8();
+	state->contentName = ContentName(config_.widget);
+	state->placeholderSvgPath = placeholderSvgPath_;
+	state->label = label_;
+	state->labelPrev = labelPrev_;
+	state->generation = configGeneration_;
+
+	reclaimStates(false);
+	const RenderState *old = state_.exchange(state);
+	if (old)
+		retired_.append({old, GetRenderFrameContext()->frame()});
+}
+
+void CellRenderer::reclaimStates(bool all)
+{
+	uint64_t frame = GetRenderFrameContext()->frame();
+	for (int i = 0; i < retired_.size();) {
+		if (all || frame >= retired_[i].frame + 2) {
+			delete retired_[i].state;
+			retired_.removeAt(i);
+		} else {
+			i++;
+		}
+	}
+}
+
+// Graphics thread: pick up per-state changes when a new config arrives
+void CellRenderer::applyState(const RenderState *state)
+{
+	drawState_ = state;
+	if (state->generation == appliedGeneration_)
+		return;
+	appliedGeneration_ = state->generation;
+
+	// Resolved lazily and cached as a weak reference
+	contentSource_.setName(state->contentName);
+	holdValid_ = false;
+	obs_weak_source_release(lastGoodSource_);
+	lastGoodSource_ = nullptr;
 }
 
+// obs_display_resize rebuilds the swap chain even for the same size, and
+// layouts are reapplied on every config edit, so unchanged sizes are skipped
 void CellRenderer::resize(uint32_t width, uint32_t height)
 {
-	if (display_)
+	if (display_ && (width != displayW_ || height != displayH_)) {
 		obs_display_resize(display_, width, height);
+		displayW_ = width;
+		displayH_ = height;
+	}
+}
+
+void CellRenderer::setVisible(bool visible)
+{
+	if (visible_ == visible)
+		return;
+
+	visible_ = visible;
+	if (display_)
+		obs_display_set_enabled(display_, displayEnabled());
+	updateShowing();
+}
+
+void CellRenderer::updateShowing()
+{
+	obs_source_t *source = nullptr;
+	if (visible_) {
+		QString name = ContentName(config_.widget);
+		if (!name.isEmpty())
+			source = obs_get_source_by_name(name.toUtf8().constData());
+	}
+
+	// Keep the existing reference if the source did not change, so a
+	// config edit does not briefly hide it and restart browser sources
+	if (source && showingSource_ && obs_weak_source_references_source(showingSource_, source)) {
+		obs_source_release(source);
+		return;
+	}
+
+	if (source) {
+		obs_source_inc_showing(source);
+		releaseShowing();
+		showingSource_ = obs_source_get_weak_source(source);
+		obs_source_release(source);
+	} else {
+		releaseShowing();
+	}
+}
+
+void CellRenderer::releaseShowing()
+{
+	if (!showingSource_)
+		return;
+
+	obs_source_t *source = obs_weak_source_get_source(showingSource_);
+	if (source) {
+		obs_source_dec_showing(source);
+		obs_source_release(source);
+	}
+	obs_weak_source_release(showingSource_);
+	showingSource_ = nullptr;
 }
 
 void CellRenderer::DrawCallback(void *data, uint32_t cx, uint32_t cy)
 {
 	auto *self = (CellRenderer *)data;
-	self->render(cx, cy);
+	self->originX_ = 0;
+	self->originY_ = 0;
+	self->render(cx, cy, self->overlay_);
+	self->overlay_.flush(cx, cy);
+}
+
+void CellRenderer::renderComposited(int x, int y, uint32_t cx, uint32_t cy, OverlayBatcher &overlays)
+{
+	originX_ = x;
+	originY_ = y;
+	render(cx, cy, overlays);
+}
+
+// All cell drawing goes through this so the same code can target either a
+// dedicated display (origin 0,0) or a sub-rectangle of a shared display.
+void CellRenderer::setViewport(int x, int y, int cx, int cy)
+{
+	gs_set_viewport(originX_ + x, originY_ + y, cx, cy);
 }
 
-void CellRenderer::render(uint32_t cx, uint32_t cy)
+void CellRenderer::render(uint32_t cx, uint32_t cy, OverlayBatcher &overlays)
 {
 	if (cx == 0 || cy == 0)
 		return;
 
+	const RenderState *state = state_.load(std::memory_order_acquire);
+	if (!state)
+		return;
+	applyState(state);
+
+	if (drawState_->widget.type == WidgetType::None)
+		return;
+
+	RenderGovernor *governor = GetRenderGovernor();
+	uint64_t drawStart = os_gettime_ns();
+
+	if (drawState_->widget.type == WidgetType::Placeholder) {
+		renderStatic(cx, cy);
+		governor->addDrawTime(os_gettime_ns() - drawStart);
+		return;
+	}
+
 	obs_source_t *source = nullptr;
+	if (drawState_->widget.type == WidgetType::Scene || drawState_->widget.type == WidgetType::Source)
+		source = contentSource_.get();
+
+	// Program/preview content is never throttled by the governor, whether
+	// it is a Preview/Program cell or a scene that is currently live
+	bool throttled = false;
+	if (governor->divisor() > 1 && drawState_->widget.type != WidgetType::Preview &&
+	    drawState_->widget.type != WidgetType::Program)
+		throttled = GetTallyState()->stateFor(source) == TALLY_NONE;
+
+	if (throttled || drawState_->widget.maxFps > 0 || drawState_->widget.renderScale < 100)
+		renderBudgeted(source, cx, cy, throttled);
+	else
+		renderContent(source, cx, cy);
 
-	switch (config_.widget.type) {
+	// Overlays are always drawn at full cell resolution
+	queueOverlays(source, cx, cy, overlays);
+	obs_source_release(source);
+
+	governor->addDrawTime(os_gettime_ns() - drawStart);
+}
+
+void CellRenderer::renderContent(obs_source_t *source, uint32_t cx, uint32_t cy)
+{
+	// Set by the content path that draws something
+	contentW_ = 0;
+	contentH_ = 0;
+	contentStale_ = false;
+
+	switch (drawState_->widget.type) {
 	case WidgetType::Preview:
 		renderPreviewProgram(cx, cy, false);
-		renderLabel(cx, cy);
-		renderStatusBorder(cx, cy);
-		return;
+		break;
 	case WidgetType::Program:
 		renderPreviewProgram(cx, cy, true);
-		renderLabel(cx, cy);
-		renderStatusBorder(cx, cy);
-		return;
+		break;
 	case WidgetType::Canvas:
 		renderCanvas(cx, cy);
-		renderLabel(cx, cy);
-		return;
-	case WidgetType::Scene: {
-		if (!config_.widget.sceneName.isEmpty())
-			source = obs_get_source_by_name(config_.widget.sceneName.toUtf8().constData());
 		break;
-	}
-	case WidgetType::Source: {
-		if (!config_.widget.sourceName.isEmpty())
-			source = obs_get_source_by_name(config_.widget.sourceName.toUtf8().constData());
+	case WidgetType::Scene:
+	case WidgetType::Source:
+		renderSource(source, cx, cy);
+		break;
+	case WidgetType::Placeholder: {
+		ImageCache::Image image;
+		QRect rect;
+		if (placeholderImage(cx, cy, image, rect))
+			renderPlaceholderIcon(image, rect);
 		break;
 	}
-	case WidgetType::Placeholder:
-		renderPlaceholderIcon(cx, cy);
-		renderLabel(cx, cy);
-		return;
 	case WidgetType::None:
 	default:
-		return;
+		break;
 	}
+}
 
-	if (source) {
-		renderSource(source, cx, cy);
-		obs_source_release(source);
+// --- Per-cell update rate and render resolution budgets ---
+
+bool CellRenderer::holdUpdateDue(uint64_t now) const
+{
+	if (drawState_->widget.maxFps <= 0)
+		return true;
+
+	// Allow half a frame of slack so e.g. 30 fps on a 60 fps output updates
+	// on every second frame instead of drifting to every third
+	uint64_t interval = 1000000000ULL / (uint64_t)drawState_->widget.maxFps;
+	uint64_t slack = obs_get_frame_interval_ns() / 2;
+	return now - holdUpdateNs_ + slack >= interval;
+}
+
+void CellRenderer::renderBudgeted(obs_source_t *source, uint32_t cx, uint32_t cy, bool throttled)
+{
+	int scale = qBound(1, drawState_->widget.renderScale, 100);
+	uint32_t texW = qMax(1u, cx * (uint32_t)scale / 100);
+	uint32_t texH = qMax(1u, cy * (uint32_t)scale / 100);
+
+	uint64_t now = os_gettime_ns();
+	bool sizeChanged = texW != holdTexW_ || texH != holdTexH_;
+	bool due = holdUpdateDue(now);
+	if (due && throttled)
+		due = GetRenderGovernor()->shouldUpdate(governorPhase_, GetRenderFrameContext()->frame());
+
+	if (!holdTexrender_ || !holdValid_ || sizeChanged || due) {
+		if (!holdTexrender_)
+			holdTexrender_ = gs_texrender_create(GS_RGBA, GS_ZS_NONE);
+
+		gs_texrender_reset(holdTexrender_);
+		if (gs_texrender_begin(holdTexrender_, texW, texH)) {
+			struct vec4 black;
+			vec4_set(&black, 0.0f, 0.0f, 0.0f, 1.0f);
+			gs_clear(GS_CLEAR_COLOR, &black, 0.0f, 0);
+
+			// Content functions position themselves relative to the cell
+			// origin; inside the texrender that origin is (0, 0)
+			int savedX = originX_;
+			int savedY = originY_;
+			originX_ = 0;
+			originY_ = 0;
+			renderContent(source, texW, texH);
+			originX_ = savedX;
+			originY_ = savedY;
+
+			gs_texrender_end(holdTexrender_);
+			holdTexW_ = texW;
+			holdTexH_ = texH;
+			holdValid_ = true;
+			holdUpdateNs_ = now;
+		}
+	}
+
+	drawHoldTexture(cx, cy);
+}
+
+// Placeholder cells never change between config edits, so image and label
+// are rendered once and every later frame is a single opaque blit
+void CellRenderer::renderStatic(uint32_t cx, uint32_t cy)
+{
+	// Images and labels are rasterized asynchronously; render again once
+	// the ones drawn change
+	ImageCache::Image image;
+	QRect imageRect;
+	bool hasImage = placeholderImage(cx, cy, image, imageRect);
+	uint64_t imageId = hasImage ? image.id : 0;
+
+	LabelLayout label;
+	LabelAtlas::Glyph glyph;
+	QString labelKey;
+	bool hasLabel = frameLabel(cx, cy, label, glyph, labelKey);
+
+	if (!holdTexrender_ || !holdValid_ || cx != holdTexW_ || cy != holdTexH_ || labelKey != holdLabelKey_ ||
+	    imageId != holdImageId_) {
+		if (!holdTexrender_)
+			holdTexrender_ = gs_texrender_create(GS_RGBA, GS_ZS_NONE);
+
+		gs_texrender_reset(holdTexrender_);
+		if (gs_texrender_begin(holdTexrender_, cx, cy)) {
+			struct vec4 black;
+			vec4_set(&black, 0.0f, 0.0f, 0.0f, 1.0f);
+			gs_clear(GS_CLEAR_COLOR, &black, 0.0f, 0);
+
+			int savedX = originX_;
+			int savedY = originY_;
+			originX_ = 0;
+			originY_ = 0;
+			if (hasImage)
+				renderPlaceholderIcon(image, imageRect);
+			if (hasLabel)
+				queueLabelBackground(label, overlay_);
+			if (!labelKey.isEmpty())
+				queueLabelText(label, glyph, overlay_);
+			overlay_.flush(cx, cy);
+			originX_ = savedX;
+			originY_ = savedY;
+
+			gs_texrender_end(holdTexrender_);
+			holdTexW_ = cx;
+			holdTexH_ = cy;
+			holdLabelKey_ = labelKey;
+			holdImageId_ = imageId;
+			holdValid_ = true;
+		}
 	}
-	renderLabel(cx, cy);
-	renderStatusBorder(cx, cy);
+
+	drawHoldTexture(cx, cy);
+}
+
+void CellRenderer::drawHoldTexture(uint32_t cx, uint32_t cy)
+{
+	gs_texture_t *tex = holdTexrender_ ? gs_texrender_get_texture(holdTexrender_) : nullptr;
+	if (!tex)
+		return;
+
+	// Between updates the last rendered texture is stretched over the cell
+	gs_viewport_push();
+	gs_projection_push();
+	setViewport(0, 0, cx, cy);
+	gs_ortho(0.0f, (float)cx, 0.0f, (float)cy, -100.0f, 100.0f);
+
+	gs_blend_state_push();
+	gs_enable_blending(false);
+
+	gs_effect_t *effect = obs_get_base_effect(OBS_EFFECT_DEFAULT);
+	gs_eparam_t *imageParam = gs_effect_get_param_by_name(effect, "image");
+	gs_effect_set_texture(imageParam, tex);
+
+	while (gs_effect_loop(effect, "Draw"))
+		gs_draw_sprite(tex, 0, cx, cy);
+
+	gs_blend_state_pop();
+
+	gs_projection_pop();
+	gs_viewport_pop();
+}
+
+// Called from cleanup/destructor; the display no longer draws this cell, so
+// the graphics thread destroys the render target at its next frame
+void CellRenderer::destroyHoldTexture()
+{
+	GetGpuReleaseQueue()->releaseTexrender(holdTexrender_);
+	holdTexrender_ = nullptr;
+	holdValid_ = false;
+	holdTexW_ = 0;
+	holdTexH_ = 0;
+	holdLabelKey_.clear();
+	holdImageId_ = 0;
 }
 
 // Rec. ITU-R BT.1848-1 / EBU R 95 safe area constants
@@ -203,130 +605,51 @@ void CellRenderer::render(uint32_t cx, uint32_t cy)
 #define GRAPHICS_SAFE_PERCENT 0.05f
 #define FOURBYTHREE_SAFE_PERCENT 0.1625f
 
-void CellRenderer::initSafeAreaGeometry()
-{
-	// Build pre-built vertex buffers with normalized 0-1 coordinates,
-	// matching OBS Studio's InitSafeAreas() from display-helpers.hpp.
-	// Already in graphics context (called from draw callback).
-
-	// Action safe margin (3.5% inset)
-	gs_render_start(true);
-	gs_vertex2f(ACTION_SAFE_PERCENT, ACTION_SAFE_PERCENT);
-	gs_vertex2f(ACTION_SAFE_PERCENT, 1 - ACTION_SAFE_PERCENT);
-	gs_vertex2f(1 - ACTION_SAFE_PERCENT, 1 - ACTION_SAFE_PERCENT);
-	gs_vertex2f(1 - ACTION_SAFE_PERCENT, ACTION_SAFE_PERCENT);
-	gs_vertex2f(ACTION_SAFE_PERCENT, ACTION_SAFE_PERCENT);
-	actionSafeVb_ = gs_render_save();
-
-	// Graphics safe margin (5% inset)
-	gs_render_start(true);
-	gs_vertex2f(GRAPHICS_SAFE_PERCENT, GRAPHICS_SAFE_PERCENT);
-	gs_vertex2f(GRAPHICS_SAFE_PERCENT, 1 - GRAPHICS_SAFE_PERCENT);
-	gs_vertex2f(1 - GRAPHICS_SAFE_PERCENT, 1 - GRAPHICS_SAFE_PERCENT);
-	gs_vertex2f(1 - GRAPHICS_SAFE_PERCENT, GRAPHICS_SAFE_PERCENT);
-	gs_vertex2f(GRAPHICS_SAFE_PERCENT, GRAPHICS_SAFE_PERCENT);
-	graphicsSafeVb_ = gs_render_save();
-
-	// 4:3 safe area for widescreen
-	gs_render_start(true);
-	gs_vertex2f(FOURBYTHREE_SAFE_PERCENT, GRAPHICS_SAFE_PERCENT);
-	gs_vertex2f(1 - FOURBYTHREE_SAFE_PERCENT, GRAPHICS_SAFE_PERCENT);
-	gs_vertex2f(1 - FOURBYTHREE_SAFE_PERCENT, 1 - GRAPHICS_SAFE_PERCENT);
-	gs_vertex2f(FOURBYTHREE_SAFE_PERCENT, 1 - GRAPHICS_SAFE_PERCENT);
-	gs_vertex2f(FOURBYTHREE_SAFE_PERCENT, GRAPHICS_SAFE_PERCENT);
-	fourByThreeSafeVb_ = gs_render_save();
-
-	// Center tick marks
-	gs_render_start(true);
-	gs_vertex2f(0.0f, 0.5f);
-	gs_vertex2f(LINE_LENGTH, 0.5f);
-	leftLineVb_ = gs_render_save();
-
-	gs_render_start(true);
-	gs_vertex2f(0.5f, 0.0f);
-	gs_vertex2f(0.5f, LINE_LENGTH);
-	topLineVb_ = gs_render_save();
-
-	gs_render_start(true);
-	gs_vertex2f(1.0f, 0.5f);
-	gs_vertex2f(1 - LINE_LENGTH, 0.5f);
-	rightLineVb_ = gs_render_save();
-}
-
-void CellRenderer::destroySafeAreaGeometry()
-{
-	obs_enter_graphics();
-	gs_vertexbuffer_destroy(actionSafeVb_);
-	gs_vertexbuffer_destroy(graphicsSafeVb_);
-	gs_vertexbuffer_destroy(fourByThreeSafeVb_);
-	gs_vertexbuffer_destroy(leftLineVb_);
-	gs_vertexbuffer_destroy(topLineVb_);
-	gs_vertexbuffer_destroy(rightLineVb_);
-	obs_leave_graphics();
-	actionSafeVb_ = nullptr;
-	graphicsSafeVb_ = nullptr;
-	fourByThreeSafeVb_ = nullptr;
-	leftLineVb_ = nullptr;
-	topLineVb_ = nullptr;
-	rightLineVb_ = nullptr;
-}
-
-void CellRenderer::renderSafeAreas(int contentW, int contentH)
-{
-	// Lazily create vertex buffers on first use (already in graphics context)
-	if (!actionSafeVb_)
-		initSafeAreaGeometry();
-
-	// Scale matrix from normalized 0-1 coordinates to content dimensions
-	matrix4 transform;
-	matrix4_identity(&transform);
-	transform.x.x = (float)contentW;
-	transform.y.y = (float)contentH;
-
-	gs_matrix_push();
-	gs_matrix_mul(&transform);
-
-	gs_effect_t *solid = obs_get_base_effect(OBS_EFFECT_SOLID);
-	gs_eparam_t *color = gs_effect_get_param_by_name(solid, "color");
-	gs_effect_set_color(color, OUTLINE_COLOR);
-
-	// Draw all six safe area elements in a single effect loop
-	while (gs_effect_loop(solid, "Solid")) {
-		gs_load_vertexbuffer(actionSafeVb_);
-		gs_draw(GS_LINESTRIP, 0, 0);
-
-		gs_load_vertexbuffer(graphicsSafeVb_);
-		gs_draw(GS_LINESTRIP, 0, 0);
-
-		gs_load_vertexbuffer(fourByThreeSafeVb_);
-		gs_draw(GS_LINESTRIP, 0, 0);
-
-		gs_load_vertexbuffer(leftLineVb_);
-		gs_draw(GS_LINESTRIP, 0, 0);
-
-		gs_load_vertexbuffer(topLineVb_);
-		gs_draw(GS_LINESTRIP, 0, 0);
-
-		gs_load_vertexbuffer(rightLineVb_);
-		gs_draw(GS_LINESTRIP, 0, 0);
-	}
-
-	gs_matrix_pop();
+// Safe-area guides, matching OBS Studio's InitSafeAreas() from
+// display-helpers.hpp, queued as 1px lines around the content rectangle
+void CellRenderer::queueSafeAreas(int x, int y, int cx, int cy, OverlayBatcher &overlays)
+{
+	float left = (float)(originX_ + x);
+	float top = (float)(originY_ + y);
+	float w = (float)cx;
+	float h = (float)cy;
+
+	auto frame = [&](float insetX, float insetY) {
+		float fx = std::round(left + w * insetX);
+		float fy = std::round(top + h * insetY);
+		float fw = std::round(left + w * (1.0f - insetX)) - fx;
+		float fh = std::round(top + h * (1.0f - insetY)) - fy;
+		overlays.addFrame(fx, fy, fw, fh, 1.0f, OUTLINE_COLOR);
+	};
+
+	// Action safe (3.5%), graphics safe (5%) and 4:3 safe for widescreen
+	frame(ACTION_SAFE_PERCENT, ACTION_SAFE_PERCENT);
+	frame(GRAPHICS_SAFE_PERCENT, GRAPHICS_SAFE_PERCENT);
+	frame(FOURBYTHREE_SAFE_PERCENT, GRAPHICS_SAFE_PERCENT);
+
+	// Center tick marks on the left, top and right edges
+	float midX = std::round(left + w * 0.5f);
+	float midY = std::round(top + h * 0.5f);
+	float tickW = std::round(w * LINE_LENGTH);
+	float tickH = std::round(h * LINE_LENGTH);
+	overlays.addRect(left, midY, tickW, 1.0f, OUTLINE_COLOR);
+	overlays.addRect(midX, top, 1.0f, tickH, OUTLINE_COLOR);
+	overlays.addRect(left + w - tickW, midY, tickW, 1.0f, OUTLINE_COLOR);
 }
 
 // OBS multiview-style status colors (ARGB)
 static const uint32_t previewColor = 0xFF00D000;
 static const uint32_t programColor = 0xFFD00000;
 
-void CellRenderer::renderStatusBorder(uint32_t cx, uint32_t cy)
+void CellRenderer::queueStatusBorder(obs_source_t *source, uint32_t cx, uint32_t cy, OverlayBatcher &overlays)
 {
-	if (!config_.widget.showStatus)
+	if (!drawState_->widget.showStatus)
 		return;
 
 	// Determine border color based on widget type and current OBS state
 	uint32_t borderColor = 0;
 
-	switch (config_.widget.type) {
+	switch (drawState_->widget.type) {
 	// case WidgetType::Preview:
 	// 	borderColor = previewColor;
 	// 	break;
@@ -334,27 +657,13 @@ void CellRenderer::renderStatusBorder(uint32_t cx, uint32_t cy)
 	// 	borderColor = programColor;
 	// 	break;
 	case WidgetType::Scene: {
-		if (config_.widget.sceneName.isEmpty())
-			return;
-		QByteArray nameUtf8 = config_.widget.sceneName.toUtf8();
-
-		// Check if this scene is the current program scene
-		obs_source_t *programScene = obs_frontend_get_current_scene();
-		if (programScene) {
-			if (strcmp(obs_source_get_name(programScene), nameUtf8.constData()) == 0)
-				borderColor = programColor;
-			obs_source_release(programScene);
-		}
-
-		// Check if this scene is the current preview scene (studio mode)
-		if (!borderColor && obs_frontend_preview_program_mode_active()) {
-			obs_source_t *previewScene = obs_frontend_get_current_preview_scene();
-			if (previewScene) {
-				if (strcmp(obs_source_get_name(previewScene), nameUtf8.constData()) == 0)
-					borderColor = previewColor;
-				obs_source_release(previewScene);
-			}
-		}
+		// Published by TallyState from frontend events; program wins over
+		// preview, and preview is only reported in studio mode
+		uint32_t tally = GetTallyState()->stateFor(source);
+		if (tally & TALLY_PROGRAM)
+			borderColor = programColor;
+		else if (tally & TALLY_PREVIEW)
+			borderColor = previewColor;
 		break;
 	}
 	default:
@@ -364,56 +673,17 @@ void CellRenderer::renderStatusBorder(uint32_t cx, uint32_t cy)
 	if (!borderColor)
 		return;
 
-	// Draw border as 4 filled strips around the cell edges
+	// Border as 4 filled strips around the cell edges
 	const int borderW = qMax(2, (int)(qMin(cx, cy) * 0.015f));
-
-	gs_effect_t *solid = obs_get_base_effect(OBS_EFFECT_SOLID);
-	gs_eparam_t *color = gs_effect_get_param_by_name(solid, "color");
-	gs_effect_set_color(color, borderColor);
-
-	gs_viewport_push();
-	gs_projection_push();
-	gs_set_viewport(0, 0, cx, cy);
-	gs_ortho(0.0f, (float)cx, 0.0f, (float)cy, -100.0f, 100.0f);
-
-	while (gs_effect_loop(solid, "Solid")) {
-		// Top strip
-		gs_draw_sprite(nullptr, 0, cx, borderW);
-
-		// Bottom strip
-		gs_matrix_push();
-		gs_matrix_translate3f(0.0f, (float)(cy - borderW), 0.0f);
-		gs_draw_sprite(nullptr, 0, cx, borderW);
-		gs_matrix_pop();
-
-		// Left strip
-		gs_matrix_push();
-		gs_matrix_translate3f(0.0f, (float)borderW, 0.0f);
-		gs_draw_sprite(nullptr, 0, borderW, cy - 2 * borderW);
-		gs_matrix_pop();
-
-		// Right strip
-		gs_matrix_push();
-		gs_matrix_translate3f((float)(cx - borderW), (float)borderW, 0.0f);
-		gs_draw_sprite(nullptr, 0, borderW, cy - 2 * borderW);
-		gs_matrix_pop();
-	}
-
-	gs_projection_pop();
-	gs_viewport_pop();
+	overlays.addFrame((float)originX_, (float)originY_, (float)cx, (float)cy, (float)borderW, borderColor);
 }
 
 void CellRenderer::renderPreviewProgram(uint32_t cx, uint32_t cy, bool isProgram)
 {
-	// Get canvas dimensions
-	struct obs_video_info ovi;
-	if (!obs_get_video_info(&ovi))
-		return;
-
-	uint32_t canvasW = ovi.base_width;
-	uint32_t canvasH = ovi.base_height;
-
-	if (canvasW == 0 || canvasH == 0)
+	// Canvas dimensions come from the shared per-frame snapshot
+	RenderFrameContext *frame = GetRenderFrameContext();
+	uint32_t canvasW, canvasH;
+	if (!frame->baseSize(canvasW, canvasH))
 		return;
 
 	// Calculate scale and offset to fit canvas in cell while maintaining aspect ratio
@@ -426,23 +696,36 @@ void CellRenderer::renderPreviewProgram(uint32_t cx, uint32_t cy, bool isProgram
 	gs_viewport_push();
 	gs_projection_push();
 
-	gs_set_viewport(offsetX, offsetY, scaledW, scaledH);
+	setViewport(offsetX, offsetY, scaledW, scaledH);
 	gs_ortho(0.0f, (float)canvasW, 0.0f, (float)canvasH, -100.0f, 100.0f);
 
 	// Program always shows main output; Preview shows the preview scene
 	// in studio mode, otherwise falls back to main output
-	if (isProgram || !obs_frontend_preview_program_mode_active()) {
+	if (isProgram || !frame->studioMode()) {
 		obs_render_main_texture();
 	} else {
-		obs_source_t *previewScene = obs_frontend_get_current_preview_scene();
-		if (previewScene) {
-			obs_source_video_render(previewScene);
-			obs_source_release(previewScene);
+		// The preview scene is rendered once per frame through the shared
+		// cache, so every Preview cell and any Scene cell showing the
+		// same scene sample one texture
+		obs_source_t *previewScene = frame->previewScene();
+		SourceTextureCache::CachedFrame cached;
+		if (previewScene && GetSourceTextureCache()->render(previewScene, scaledW, scaledH, cached)) {
+			gs_blend_state_push();
+			gs_enable_blending(false);
+
+			gs_effect_t *effect = obs_get_base_effect(OBS_EFFECT_DEFAULT);
+			gs_eparam_t *imageParam = gs_effect_get_param_by_name(effect, "image");
+			gs_effect_set_texture(imageParam, cached.texture);
+
+			while (gs_effect_loop(effect, "Draw"))
+				gs_draw_sprite(cached.texture, 0, canvasW, canvasH);
+
+			gs_blend_state_pop();
 		}
 	}
 
-	if (config_.widget.safeRegion)
-		renderSafeAreas(canvasW, canvasH);
+	contentW_ = canvasW;
+	contentH_ = canvasH;
 
 	gs_projection_pop();
 	gs_viewport_pop();
@@ -450,63 +733,23 @@ void CellRenderer::renderPreviewProgram(uint32_t cx, uint32_t cy, bool isProgram
 
 void CellRenderer::renderCanvas(uint32_t cx, uint32_t cy)
 {
-	// Get the canvas - either by name or the main canvas
-	obs_canvas_t *canvas = nullptr;
-	bool releaseCanvas = false;
-
-	if (!config_.widget.canvasName.isEmpty()) {
-		// Get canvas by name using OBS Canvas API
-		canvas = obs_get_canvas_by_name(config_.widget.canvasName.toUtf8().constData());
-		releaseCanvas = true;
-	} else {
-		// Use main canvas
-		canvas = obs_get_main_canvas();
-		releaseCanvas = true;
-	}
-
-	if (!canvas) {
-		// Fallback: render main texture if canvas not found
-		struct obs_video_info ovi;
-		if (!obs_get_video_info(&ovi))
-			return;
-
-		uint32_t canvasW = ovi.base_width;
-		uint32_t canvasH = ovi.base_height;
-		if (canvasW == 0 || canvasH == 0)
-			return;
-
-		int offsetX, offsetY, scaledW, scaledH;
-		float scale;
-		GetScaleAndCenterPos(canvasW, canvasH, cx, cy, offsetX, offsetY, scale, scaledW, scaledH);
-
-		gs_viewport_push();
-		gs_projection_push();
-		gs_set_viewport(offsetX, offsetY, scaledW, scaledH);
-		gs_ortho(0.0f, (float)canvasW, 0.0f, (float)canvasH, -100.0f, 100.0f);
-		obs_render_main_texture();
-		if (config_.widget.safeRegion)
-			renderSafeAreas(canvasW, canvasH);
-		gs_projection_pop();
-		gs_viewport_pop();
+	// Canvas handle and dimensions are resolved once per frame per distinct
+	// canvas name by the shared frame context (empty name = main canvas)
+	RenderFrameContext *frame = GetRenderFrameContext();
+	RenderFrameContext::CanvasInfo info;
+	bool found = frame->canvas(drawState_->canvasName, info);
+
+	// Fallback: render main texture if canvas not found
+	uint32_t canvasW, canvasH;
+	if (found) {
+		canvasW = info.cx;
+		canvasH = info.cy;
+	} else if (!frame->baseSize(canvasW, canvasH)) {
 		return;
 	}
 
-	// Get canvas video info for dimensions
-	struct obs_video_info ovi;
-	if (!obs_canvas_get_video_info(canvas, &ovi)) {
-		if (releaseCanvas)
-			obs_canvas_release(canvas);
-		return;
-	}
-
-	uint32_t canvasW = ovi.base_width;
-	uint32_t canvasH = ovi.base_height;
-
-	if (canvasW == 0 || canvasH == 0) {
-		if (releaseCanvas)
-			obs_canvas_release(canvas);
+	if (canvasW == 0 || canvasH == 0)
 		return;
-	}
 
 	// Calculate scale and offset to fit canvas in cell while maintaining aspect ratio
 	int offsetX, offsetY, scaledW, scaledH;
@@ -517,66 +760,173 @@ void CellRenderer::renderCanvas(uint32_t cx, uint32_t cy)
 	gs_viewport_push();
 	gs_projection_push();
 
-	gs_set_viewport(offsetX, offsetY, scaledW, scaledH);
+	setViewport(offsetX, offsetY, scaledW, scaledH);
 	gs_ortho(0.0f, (float)canvasW, 0.0f, (float)canvasH, -100.0f, 100.0f);
 
 	// Render the canvas texture using OBS Canvas API
-	obs_render_canvas_texture(canvas);
+	if (found)
+		obs_render_canvas_texture(info.canvas);
+	else
+		obs_render_main_texture();
 
-	if (config_.widget.safeRegion)
-		renderSafeAreas(canvasW, canvasH);
+	contentW_ = canvasW;
+	contentH_ = canvasH;
 
 	gs_projection_pop();
 	gs_viewport_pop();
+}
 
-	if (releaseCanvas)
-		obs_canvas_release(canvas);
+// A Scene cell showing the program scene can draw the main texture OBS
+// has already rendered this frame, as long as no transition is blending it
+// with another scene and the scene is the same size as the main canvas
+bool CellRenderer::aliasesProgram(obs_source_t *source) const
+{
+	if (drawState_->widget.type != WidgetType::Scene || !source)
+		return false;
+	if (!(GetTallyState()->stateFor(source) & TALLY_PROGRAM))
+		return false;
+
+	RenderFrameContext *frame = GetRenderFrameContext();
+	uint32_t baseW, baseH;
+	if (!frame->baseSize(baseW, baseH) || frame->transitionActive())
+		return false;
+
+	return obs_source_get_width(source) == baseW && obs_source_get_height(source) == baseH;
 }
 
 void CellRenderer::renderSource(obs_source_t *source, uint32_t cx, uint32_t cy)
 {
-	uint32_t srcW = obs_source_get_width(source);
-	uint32_t srcH = obs_source_get_height(source);
-
-	if (srcW == 0 || srcH == 0)
+	if (aliasesProgram(source)) {
+		renderPreviewProgram(cx, cy, true);
 		return;
+	}
+
+	SourceTextureCache *cache = GetSourceTextureCache();
+	SourceTextureCache::CachedFrame frame;
+	bool haveFrame = false;
+
+	uint32_t srcW = source ? obs_source_get_width(source) : 0;
+	uint32_t srcH = source ? obs_source_get_height(source) : 0;
 
-	// Calculate scale to fit while maintaining aspect ratio
 	int offsetX, offsetY, scaledW, scaledH;
 	float scale;
+
+	if (srcW && srcH) {
+		// The scene graph is walked at most once per frame across all
+		// cells and windows; every cell showing this source samples the
+		// same texture.
+		GetScaleAndCenterPos(srcW, srcH, cx, cy, offsetX, offsetY, scale, scaledW, scaledH);
+		haveFrame = cache->render(source, scaledW, scaledH, frame);
+
+		if (haveFrame && !frame.stale &&
+		    (!lastGoodSource_ || !obs_weak_source_references_source(lastGoodSource_, source))) {
+			obs_weak_source_release(lastGoodSource_);
+			lastGoodSource_ = obs_source_get_weak_source(source);
+		}
+	}
+
+	// Missing, restarting or zero-size sources keep the last frame this
+	// cell drew instead of flashing black
+	if (!haveFrame && lastGoodSource_)
+		haveFrame = cache->held(lastGoodSource_, frame);
+	if (!haveFrame)
+		return;
+
+	srcW = frame.srcW;
+	srcH = frame.srcH;
 	GetScaleAndCenterPos(srcW, srcH, cx, cy, offsetX, offsetY, scale, scaledW, scaledH);
 
 	gs_viewport_push();
 	gs_projection_push();
 
-	gs_set_viewport(offsetX, offsetY, scaledW, scaledH);
+	setViewport(offsetX, offsetY, scaledW, scaledH);
 	gs_ortho(0.0f, (float)srcW, 0.0f, (float)srcH, -100.0f, 100.0f);
 
-	obs_source_video_render(source);
+	// Opaque blit: the texture already holds the source composited over black
+	gs_blend_state_push();
+	gs_enable_blending(false);
+
+	gs_effect_t *effect = obs_get_base_effect(OBS_EFFECT_DEFAULT);
+	gs_eparam_t *imageParam = gs_effect_get_param_by_name(effect, "image");
+	gs_effect_set_texture(imageParam, frame.texture);
+
+	while (gs_effect_loop(effect, "Draw"))
+		gs_draw_sprite(frame.texture, 0, srcW, srcH);
 
-	if (config_.widget.safeRegion)
-		renderSafeAreas(srcW, srcH);
+	gs_blend_state_pop();
 
 	gs_projection_pop();
 	gs_viewport_pop();
+
+	contentW_ = srcW;
+	contentH_ = srcH;
+	contentStale_ = frame.stale;
 }
 
-// --- Label text source management ---
+// Stale frames are dimmed and marked with a small amber corner badge so a
+// frozen picture is not mistaken for a live one
+#define STALE_DIM_COLOR 0x60000000
+#define STALE_BADGE_COLOR 0xFFFFB000
 
-static const char *GetTextSourceId()
+void CellRenderer::queueStaleIndicator(int x, int y, int cx, int cy, OverlayBatcher &overlays)
 {
-#ifdef _WIN32
-	return "text_gdiplus";
-#else
-	return "text_ft2_source";
-#endif
+	const int badge = qMax(6, (int)(qMin(cx, cy) * 0.04f));
+	const int margin = qMax(2, badge / 2);
+	float left = (float)(originX_ + x);
+	float top = (float)(originY_ + y);
+
+	overlays.addRect(left, top, (float)cx, (float)cy, STALE_DIM_COLOR);
+	overlays.addRect(left + (float)(cx - margin - badge), top + (float)margin, (float)badge, (float)badge,
+			 STALE_BADGE_COLOR);
+}
+
+// Overlays for the whole cell, queued after its content and drawn by the
+// display's single overlay pass
+void CellRenderer::queueOverlays(obs_source_t *source, uint32_t cx, uint32_t cy, OverlayBatcher &overlays)
+{
+	if (contentW_ && contentH_ && (drawState_->widget.safeRegion || contentStale_)) {
+		int offsetX, offsetY, scaledW, scaledH;
+		float scale;
+		GetScaleAndCenterPos(contentW_, contentH_, cx, cy, offsetX, offsetY, scale, scaledW, scaledH);
+
+		if (drawState_->widget.safeRegion)
+			queueSafeAreas(offsetX, offsetY, scaledW, scaledH, overlays);
+		if (contentStale_)
+			queueStaleIndicator(offsetX, offsetY, scaledW, scaledH, overlays);
+	}
+
+	LabelLayout label;
+	LabelAtlas::Glyph glyph;
+	QString labelKey;
+	if (frameLabel(cx, cy, label, glyph, labelKey)) {
+		queueLabelBackground(label, overlays);
+		if (!labelKey.isEmpty())
+			queueLabelText(label, glyph, overlays);
+	}
+
+	queueStatusBorder(source, cx, cy, overlays);
 }
 
-QString CellRenderer::resolveLabelText() const
+// --- Labels ---
+
+bool CellRenderer::hasLabelTokens() const
+{
+	return config_.widget.labelVisible && config_.widget.type != WidgetType::None &&
+	       LabelTokens::HasTokens(config_.widget.labelText);
+}
+
+QString CellRenderer::resolveLabelText()
 {
 	if (!config_.widget.labelVisible || config_.widget.type == WidgetType::None)
 		return QString();
 
+	if (LabelTokens::HasTokens(config_.widget.labelText)) {
+		obs_source_t *source = tokenSource_.get();
+		QString text = LabelTokens::Expand(config_.widget.labelText, config_.widget, source);
+		obs_source_release(source);
+		return text;
+	}
+
 	if (!config_.widget.labelText.isEmpty())
 		return config_.widget.labelText;
 
@@ -599,104 +949,76 @@ QString CellRenderer::resolveLabelText() const
 	}
 }
 
-void CellRenderer::createLabelSource()
+// Live labels call this on every refresh; a new state is only published
+// when the expanded text actually changed
+void CellRenderer::refreshLabel()
 {
-	destroyLabelSource();
+	if (state_.load() && updateLabel())
+		publishState();
+}
 
+// Labels are drawn from the shared atlas; only the atlas key and native
+// size are kept per cell. Returns false if text and font are unchanged.
+bool CellRenderer::updateLabel()
+{
 	QString text = resolveLabelText();
-	if (text.isEmpty())
-		return;
-
-	// Parse font from config (QFont::toString() format) or use default
-	QFont font;
-	if (!config_.widget.labelFont.isEmpty())
-		font.fromString(config_.widget.labelFont);
-	else
-		font.setPointSize(36);
-
-	obs_data_t *settings = obs_data_create();
-	obs_data_set_string(settings, "text", text.toUtf8().constData());
-	obs_data_set_string(settings, "font_face", font.family().toUtf8().constData());
-	obs_data_set_int(settings, "font_size", font.pointSize() > 0 ? font.pointSize() : 36);
-
-	// Build font flags bitmask (bit 0 = bold, bit 1 = italic)
-	int fontFlags = 0;
-	if (font.bold())
-		fontFlags |= 1;
-	if (font.italic())
-		fontFlags |= 2;
-
-	// Derive the full style name (e.g. "Light Italic", "SemiBold") from
-	// the font's weight and italic properties so sub-weights are preserved.
-	QString style = QFontDatabase::styleString(font);
-	if (style.isEmpty())
-		style = QStringLiteral("Regular");
-
-	obs_data_t *fontData = obs_data_create();
-	obs_data_set_string(fontData, "face", font.family().toUtf8().constData());
-	obs_data_set_int(fontData, "size", font.pointSize() > 0 ? font.pointSize() : 36);
-	obs_data_set_int(fontData, "flags", fontFlags);
-	obs_data_set_string(fontData, "style", style.toUtf8().constData());
-	obs_data_set_obj(settings, "font", fontData);
-	obs_data_release(fontData);
-
-	// White text with full opacity
-	obs_data_set_int(settings, "color1", 0xFFFFFFFF);
-	obs_data_set_int(settings, "color2", 0xFFFFFFFF);
-
-	labelSource_ = obs_source_create_private(GetTextSourceId(), "lg_label", settings);
-	obs_data_release(settings);
-}
-
-void CellRenderer::destroyLabelSource()
-{
-	if (labelSource_) {
-		obs_enter_graphics();
-		obs_source_release(labelSource_);
-		obs_leave_graphics();
-		labelSource_ = nullptr;
+	if (text == labelExpanded_ && config_.widget.labelFont == labelFontDesc_)
+		return false;
+	labelExpanded_ = text;
+	labelFontDesc_ = config_.widget.labelFont;
+
+	LabelText label;
+	if (!text.isEmpty()) {
+		QFont font = LabelAtlas::LabelFont(config_.widget.labelFont);
+		LabelAtlas::Measure(font, text, label.nativeW, label.nativeH);
+		label.key = LabelAtlas::MakeKey(config_.widget.labelFont, text);
 	}
-}
 
-void CellRenderer::updateLabelSource()
-{
-	// Recreate the label source with updated config
-	createLabelSource();
+	// The old label stays up until the new one has been rasterized
+	if (!label.key.isEmpty() && !label_.key.isEmpty())
+		labelPrev_ = label_;
+	else
+		labelPrev_ = LabelText();
+	label_ = label;
+	return true;
 }
 
-// Creates a gs_texture from a QImage with a rounded rectangle filled with the
-// given color and alpha. The texture is w x h pixels with the specified corner radius.
-static gs_texture_t *CreateRoundedRectTexture(int w, int h, int radius, QColor color)
+// Label to draw this frame: the current one once its raster is in the
+// atlas, otherwise the previous one. drawnKey is empty when neither is
+// ready; the layout is then the current label's, for its background.
+bool CellRenderer::frameLabel(uint32_t cx, uint32_t cy, LabelLayout &layout, LabelAtlas::Glyph &glyph,
+			      QString &drawnKey)
 {
-	if (w <= 0 || h <= 0)
-		return nullptr;
-
-	QImage img(w, h, QImage::Format_RGBA8888_Premultiplied);
-	img.fill(Qt::transparent);
-
-	QPainter painter(&img);
-	painter.setRenderHint(QPainter::Antialiasing);
-	painter.setBrush(color);
-	painter.setPen(Qt::NoPen);
-	painter.drawRoundedRect(0, 0, w, h, radius, radius);
-	painter.end();
+	drawnKey.clear();
+	const LabelText &current = drawState_->label;
+	if (!labelLayout(cx, cy, current, layout))
+		return false;
+
+	LabelAtlas *atlas = GetLabelAtlas();
+	if (atlas->lookup(current.key, LabelPixelHeight(layout), glyph)) {
+		drawnKey = current.key;
+		return true;
+	}
 
-	// Upload to GPU — obs_enter_graphics is already active in draw callback
-	const uint8_t *bits = img.constBits();
-	gs_texture_t *tex = gs_texture_create(w, h, GS_RGBA, 1, &bits, 0);
-	return tex;
+	const LabelText &prev = drawState_->labelPrev;
+	LabelLayout prevLayout;
+	if (labelLayout(cx, cy, prev, prevLayout) && atlas->lookup(prev.key, LabelPixelHeight(prevLayout), glyph)) {
+		layout = prevLayout;
+		drawnKey = prev.key;
+	}
+	return true;
 }
 
-void CellRenderer::renderLabel(uint32_t cx, uint32_t cy)
+bool CellRenderer::labelLayout(uint32_t cx, uint32_t cy, const LabelText &label, LabelLayout &layout) const
 {
-	if (!labelSource_)
-		return;
+	if (label.key.isEmpty())
+		return false;
 
-	uint32_t labelW = obs_source_get_width(labelSource_);
-	uint32_t labelH = obs_source_get_height(labelSource_);
+	uint32_t labelW = label.nativeW;
+	uint32_t labelH = label.nativeH;
 
 	if (labelW == 0 || labelH == 0)
-		return;
+		return false;
 
 	// Scale the label proportionally to the cell size using the approach
 	// from OBS Studio's multiview. The label should occupy at most ~15%
@@ -719,7 +1041,7 @@ void CellRenderer::renderLabel(uint32_t cx, uint32_t cy)
 	int labelY = 0;
 
 	// Horizontal alignment
-	Qt::Alignment hAlign = config_.widget.labelHAlign;
+	Qt::Alignment hAlign = drawState_->widget.labelHAlign;
 	if (hAlign & Qt::AlignHCenter)
 		labelX = ((int)cx - scaledW) / 2;
 	else if (hAlign & Qt::AlignRight)
@@ -728,7 +1050,7 @@ void CellRenderer::renderLabel(uint32_t cx, uint32_t cy)
 		labelX = padding;
 
 	// Vertical alignment
-	Qt::Alignment vAlign = config_.widget.labelVAlign;
+	Qt::Alignment vAlign = drawState_->widget.labelVAlign;
 	if (vAlign & Qt::AlignVCenter)
 		labelY = ((int)cy - scaledH) / 2;
 	else if (vAlign & Qt::AlignBottom)
@@ -736,180 +1058,102 @@ void CellRenderer::renderLabel(uint32_t cx, uint32_t cy)
 	else
 		labelY = padding;
 
-	// Draw rounded background rectangle behind the label if it has any opacity.
-	// The background texture is created at the scaled pixel size so it
-	// matches the label and is recreated when dimensions or color change.
-	QColor bgColor = config_.widget.labelBgColor;
-	if (bgColor.alpha() > 0) {
-		int bgPad = qMax(1, (int)(4.0f * scale));
-		int bgRadius = qMax(1, (int)(6.0f * scale));
-		int bgX = labelX - bgPad;
-		int bgY = labelY - bgPad;
-		int bgW = scaledW + 2 * bgPad;
-		int bgH = scaledH + 2 * bgPad;
-
-		// Recreate cached texture only when dimensions or color change
-		if (!labelBgTexture_ || labelBgTexW_ != bgW || labelBgTexH_ != bgH || labelBgTexColor_ != bgColor) {
-			if (labelBgTexture_) {
-				gs_texture_destroy(labelBgTexture_);
-				labelBgTexture_ = nullptr;
-			}
-			labelBgTexture_ = CreateRoundedRectTexture(bgW, bgH, bgRadius, bgColor);
-			labelBgTexW_ = bgW;
-			labelBgTexH_ = bgH;
-			labelBgTexColor_ = bgColor;
-		}
-
-		if (labelBgTexture_) {
-			gs_blend_state_push();
-			gs_enable_blending(true);
-			gs_blend_function(GS_BLEND_SRCALPHA, GS_BLEND_INVSRCALPHA);
-
-			gs_effect_t *effect = obs_get_base_effect(OBS_EFFECT_DEFAULT);
-			gs_eparam_t *imageParam = gs_effect_get_param_by_name(effect, "image");
-			gs_effect_set_texture(imageParam, labelBgTexture_);
-
-			gs_viewport_push();
-			gs_projection_push();
-			gs_set_viewport(bgX, bgY, bgW, bgH);
-			gs_ortho(0.0f, (float)bgW, 0.0f, (float)bgH, -100.0f, 100.0f);
-
-			while (gs_effect_loop(effect, "Draw"))
-				gs_draw_sprite(labelBgTexture_, 0, bgW, bgH);
-
-			gs_projection_pop();
-			gs_viewport_pop();
-
-			gs_blend_state_pop();
-		}
-	}
+	layout.labelW = labelW;
+	layout.labelH = labelH;
+	layout.x = labelX;
+	layout.y = labelY;
+	layout.cx = scaledW;
+	layout.cy = scaledH;
+	layout.scale = scale;
+	return true;
+}
 
-	// Render the text source scaled via viewport mapping: the viewport is
-	// set to the scaled pixel area while the ortho projection spans the
-	// original label dimensions, so the GPU performs the scaling.
-	gs_viewport_push();
-	gs_projection_push();
+// Rounded background behind the label, drawn by the SDF overlay effect at
+// whatever size the label currently has
+void CellRenderer::queueLabelBackground(const LabelLayout &layout, OverlayBatcher &overlays)
+{
+	QColor bgColor = drawState_->widget.labelBgColor;
+	if (bgColor.alpha() == 0)
+		return;
 
-	gs_set_viewport(labelX, labelY, scaledW, scaledH);
-	gs_ortho(0.0f, (float)labelW, 0.0f, (float)labelH, -100.0f, 100.0f);
+	int bgPad = qMax(1, (int)(4.0f * layout.scale));
+	int bgRadius = qMax(1, (int)(6.0f * layout.scale));
+	overlays.addRoundedRect((float)(originX_ + layout.x - bgPad), (float)(originY_ + layout.y - bgPad),
+				(float)(layout.cx + 2 * bgPad), (float)(layout.cy + 2 * bgPad), (float)bgRadius,
+				(uint32_t)bgColor.rgba());
+}
 
-	obs_source_video_render(labelSource_);
+// Labels are rasterized at their displayed height, rounded up to 4px steps
+// so resizing a window does not rasterize a new size on every frame
+int CellRenderer::LabelPixelHeight(const LabelLayout &layout)
+{
+	int height = ((layout.cy + 3) / 4) * 4;
+	return qMax(4, qMin(height, (int)layout.labelH));
+}
 
-	gs_projection_pop();
-	gs_viewport_pop();
+void CellRenderer::queueLabelText(const LabelLayout &layout, const LabelAtlas::Glyph &glyph,
+				  OverlayBatcher &overlays)
+{
+	overlays.addTexturedRect((float)(originX_ + layout.x), (float)(originY_ + layout.y), (float)layout.cx,
+				 (float)layout.cy, glyph.texture, glyph.u0, glyph.v0, glyph.u1, glyph.v1);
 }
 
-// --- Placeholder icon rendering ---
+// --- Placeholder images ---
 
 void CellRenderer::setPlaceholderSvgPath(const QString &path)
 {
 	placeholderSvgPath_ = path;
+	if (state_.load())
+		publishState();
 }
 
 // Called from the draw callback (graphics context already active)
-void CellRenderer::createPlaceholderTexture()
-{
-	// Destroy old texture directly (we're in graphics context)
-	if (placeholderTexture_) {
-		gs_texture_destroy(placeholderTexture_);
-		placeholderTexture_ = nullptr;
-		placeholderTexSize_ = 0;
-	}
-
-	if (placeholderSvgPath_.isEmpty())
-		return;
-
-	// Determine icon size: 50% of cell dimension, min 16px
-	int cellW = surface_ ? surface_->width() : 0;
-	int cellH = surface_ ? surface_->height() : 0;
-	int iconSize = qMin(cellW, cellH) / 2;
-	if (iconSize < 16)
-		iconSize = 16;
-
-	// Render SVG to QImage
-	QSvgRenderer svgRenderer(placeholderSvgPath_);
-	if (!svgRenderer.isValid())
-		return;
-
-	QImage img(iconSize, iconSize, QImage::Format_RGBA8888_Premultiplied);
-	img.fill(Qt::transparent);
-	QPainter painter(&img);
-	painter.setRenderHint(QPainter::Antialiasing);
-	painter.setRenderHint(QPainter::SmoothPixmapTransform);
-	svgRenderer.render(&painter);
-	painter.end();
-
-	// Upload to GPU (already in graphics context)
-	const uint8_t *bits = img.constBits();
-	placeholderTexture_ = gs_texture_create(iconSize, iconSize, GS_RGBA, 1, &bits, 0);
-	placeholderTexSize_ = iconSize;
-}
-
-// Called from cleanup/destructor (graphics context may not be active)
-void CellRenderer::destroyPlaceholderTexture()
-{
-	if (placeholderTexture_) {
-		obs_enter_graphics();
-		gs_texture_destroy(placeholderTexture_);
-		obs_leave_graphics();
-		placeholderTexture_ = nullptr;
-		placeholderTexSize_ = 0;
-	}
-}
-
-// Called from cleanup/destructor (graphics context may not be active)
-void CellRenderer::destroyLabelBgTexture()
+// The cell's own image scaled to fit the cell, or the default icon at half
+// the cell size. Falls back to the icon if the cell's image cannot be loaded.
+bool CellRenderer::placeholderImage(uint32_t cx, uint32_t cy, ImageCache::Image &image, QRect &rect)
 {
-	if (labelBgTexture_) {
-		obs_enter_graphics();
-		gs_texture_destroy(labelBgTexture_);
-		obs_leave_graphics();
-		labelBgTexture_ = nullptr;
-		labelBgTexW_ = 0;
-		labelBgTexH_ = 0;
-		labelBgTexColor_ = QColor();
+	ImageCache *cache = GetImageCache();
+	int boxW = (int)cx;
+	int boxH = (int)cy;
+
+	const QString &custom = drawState_->widget.placeholderPath;
+	bool useCustom = !custom.isEmpty() &&
+			 cache->lookup(custom, qMax(boxW, boxH), image) != ImageCache::Status::Failed;
+	if (!useCustom) {
+		if (drawState_->placeholderSvgPath.isEmpty())
+			return false;
+		boxW = boxH = qMax(16, qMin((int)cx, (int)cy) / 2);
+		if (cache->lookup(drawState_->placeholderSvgPath, boxW, image) == ImageCache::Status::Failed)
+			return false;
 	}
+	if (!image.texture)
+		return false;
+
+	// Preserve aspect ratio and center in the cell
+	float scale = qMin((float)boxW / (float)image.cx, (float)boxH / (float)image.cy);
+	int drawW = qMax(1, (int)(image.cx * scale));
+	int drawH = qMax(1, (int)(image.cy * scale));
+	rect = QRect(((int)cx - drawW) / 2, ((int)cy - drawH) / 2, drawW, drawH);
+	return true;
 }
 
-void CellRenderer::renderPlaceholderIcon(uint32_t cx, uint32_t cy)
+void CellRenderer::renderPlaceholderIcon(const ImageCache::Image &image, const QRect &rect)
 {
-	if (placeholderSvgPath_.isEmpty())
-		return;
-
-	// Determine desired icon size for the current cell dimensions
-	int desiredSize = qMin((int)cx, (int)cy) / 2;
-	if (desiredSize < 16)
-		desiredSize = 16;
-
-	// Recreate texture if size changed or not yet created
-	if (!placeholderTexture_ || placeholderTexSize_ != desiredSize)
-		createPlaceholderTexture();
-
-	if (!placeholderTexture_)
-		return;
-
-	int iconW = placeholderTexSize_;
-	int iconH = placeholderTexSize_;
-
-	// Center the icon in the cell
-	int iconX = ((int)cx - iconW) / 2;
-	int iconY = ((int)cy - iconH) / 2;
-
 	gs_blend_state_push();
 	gs_enable_blending(true);
-	gs_blend_function(GS_BLEND_SRCALPHA, GS_BLEND_INVSRCALPHA);
+	gs_blend_function(GS_BLEND_ONE, GS_BLEND_INVSRCALPHA);
 
 	gs_effect_t *effect = obs_get_base_effect(OBS_EFFECT_DEFAULT);
 	gs_eparam_t *imageParam = gs_effect_get_param_by_name(effect, "image");
-	gs_effect_set_texture(imageParam, placeholderTexture_);
+	gs_effect_set_texture(imageParam, image.texture);
 
 	gs_viewport_push();
 	gs_projection_push();
-	gs_set_viewport(iconX, iconY, iconW, iconH);
-	gs_ortho(0.0f, (float)iconW, 0.0f, (float)iconH, -100.0f, 100.0f);
+	setViewport(rect.x(), rect.y(), rect.width(), rect.height());
+	gs_ortho(0.0f, (float)image.cx, 0.0f, (float)image.cy, -100.0f, 100.0f);
 
 	while (gs_effect_loop(effect, "Draw"))
-		gs_draw_sprite(placeholderTexture_, 0, iconW, iconH);
+		gs_draw_sprite(image.texture, 0, image.cx, image.cy);
 
 	gs_projection_pop();
 	gs_viewport_pop();
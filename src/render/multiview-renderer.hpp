@@ -19,19 +19,37 @@ with this program. If not, see <https://www.gnu.org/licenses/>
 #pragma once
 
 #include "../core/multiview-config.hpp"
+#include "source-resolver.hpp"
+#include "overlay-batcher.hpp"
+#include "label-atlas.hpp"
+#include "image-cache.hpp"
 
 #include <obs.h>
 #include <graphics/graphics.h>
 
+#include <QRect>
 #include <QString>
+#include <QVector>
 #include <QWidget>
 
+#include <atomic>
+#include <cstdint>
+
+// Creates a black-cleared obs_display_t for a realized native widget
+obs_display_t *CreateSurfaceDisplay(QWidget *surface);
+
 /**
  * Renders a single multiview cell using an OBS display.
- * Each cell gets its own obs_display_t backed by a native window surface,
- * and renders the configured content (preview, program, canvas, scene, or source)
+ * By default each cell gets its own obs_display_t backed by a native window
+ * surface. In compositor mode the cell has no display and is drawn into a
+ * sub-rectangle of the window's shared display by MultiviewCompositor.
+ * Renders the configured content (preview, program, canvas, scene, or source)
  * with aspect-ratio-preserving scaling. Labels and placeholder icons are rendered
  * as OBS graphics overlays composited on top of the cell content.
+ *
+ * Configuration is edited on the UI thread and handed to the graphics thread
+ * as immutable RenderState snapshots swapped in through an atomic pointer,
+ * so draws never take a lock or see a half-applied edit.
  */
 class CellRenderer {
 public:
@@ -39,52 +57,156 @@ public:
 	~CellRenderer();
 
 	void init(QWidget *surface, const CellConfig &config);
+	void initComposited(const CellConfig &config);
 	void cleanup();
 	void updateConfig(const CellConfig &config);
 	void resize(uint32_t width, uint32_t height);
 
-	// Set the SVG file path for placeholder icon rendering
+	// Suspend drawing while the cell cannot be seen (UI thread). Hidden
+	// cells also drop their show reference on the displayed source so
+	// browser/media sources that only appear here can idle.
+	void setVisible(bool visible);
+
+	// Whether the label text contains live tokens (see LabelTokens)
+	bool hasLabelTokens() const;
+
+	// Re-expand the label text (UI thread); cheap when nothing changed
+	void refreshLabel();
+
+	// Default placeholder icon, used when a cell has no image of its own
 	void setPlaceholderSvgPath(const QString &path);
 
+	// Draw this cell at (x, y) of the current display (graphics thread
+	// only). Overlays and labels are queued into the display's batcher.
+	void renderComposited(int x, int y, uint32_t cx, uint32_t cy, OverlayBatcher &overlays);
+
 private:
+	// Atlas key and native size of a label; an empty key means no label
+	struct LabelText {
+		QString key;
+		uint32_t nativeW = 0;
+		uint32_t nativeH = 0;
+	};
+
+	// Everything the draw callback reads from the cell's configuration
+	struct RenderState {
+		WidgetConfig widget;
+		QByteArray canvasName; // Canvas cells; empty means main canvas
+		QString contentName;   // Scene or source shown by Scene/Source cells
+		QString placeholderSvgPath;
+		LabelText label;
+		LabelText labelPrev;      // Drawn until label has been rasterized
+		uint64_t generation = 0; // Config edit the state belongs to
+	};
+
+	struct RetiredState {
+		const RenderState *state;
+		uint64_t frame; // Frame index when it was replaced
+	};
+
+	// Label position within the cell and the label's native size
+	struct LabelLayout {
+		uint32_t labelW = 0;
+		uint32_t labelH = 0;
+		int x = 0;
+		int y = 0;
+		int cx = 0;
+		int cy = 0;
+		float scale = 1.0f;
+	};
+
 	static void DrawCallback(void *data, uint32_t cx, uint32_t cy);
-	void render(uint32_t cx, uint32_t cy);
+	void render(uint32_t cx, uint32_t cy, OverlayBatcher &overlays);
+	void renderContent(obs_source_t *source, uint32_t cx, uint32_t cy);
+	void renderBudgeted(obs_source_t *source, uint32_t cx, uint32_t cy, bool throttled);
+	bool holdUpdateDue(uint64_t now) const;
+	void renderStatic(uint32_t cx, uint32_t cy);
+	void drawHoldTexture(uint32_t cx, uint32_t cy);
+	void setViewport(int x, int y, int cx, int cy);
 	void renderPreviewProgram(uint32_t cx, uint32_t cy, bool isProgram);
 	void renderCanvas(uint32_t cx, uint32_t cy);
 	void renderSource(obs_source_t *source, uint32_t cx, uint32_t cy);
-	void renderLabel(uint32_t cx, uint32_t cy);
-	void renderPlaceholderIcon(uint32_t cx, uint32_t cy);
-	void renderSafeAreas(int contentW, int contentH);
-	void initSafeAreaGeometry();
-	void renderStatusBorder(uint32_t cx, uint32_t cy);
-
-	void createLabelSource();
-	void destroyLabelSource();
-	void updateLabelSource();
-	QString resolveLabelText() const;
-
-	void createPlaceholderTexture();
-	void destroyPlaceholderTexture();
-	void destroyLabelBgTexture();
-	void destroySafeAreaGeometry();
+	bool aliasesProgram(obs_source_t *source) const;
+	bool placeholderImage(uint32_t cx, uint32_t cy, ImageCache::Image &image, QRect &rect);
+	void renderPlaceholderIcon(const ImageCache::Image &image, const QRect &rect);
+	bool labelLayout(uint32_t cx, uint32_t cy, const LabelText &label, LabelLayout &layout) const;
+	bool frameLabel(uint32_t cx, uint32_t cy, LabelLayout &layout, LabelAtlas::Glyph &glyph, QString &drawnKey);
+	static int LabelPixelHeight(const LabelLayout &layout);
+
+	void queueOverlays(obs_source_t *source, uint32_t cx, uint32_t cy, OverlayBatcher &overlays);
+	void queueSafeAreas(int x, int y, int cx, int cy, OverlayBatcher &overlays);
+	void queueStaleIndicator(int x, int y, int cx, int cy, OverlayBatcher &overlays);
+	void queueLabelBackground(const LabelLayout &layout, OverlayBatcher &overlays);
+	void queueLabelText(const LabelLayout &layout, const LabelAtlas::Glyph &glyph, OverlayBatcher &overlays);
+	void queueStatusBorder(obs_source_t *source, uint32_t cx, uint32_t cy, OverlayBatcher &overlays);
+
+	QString resolveLabelText();
+	bool updateLabel();
+	bool displayEnabled() const;
+	void applyConfig();
+	void publishState();
+	void reclaimStates(bool all);
+	void applyState(const RenderState *state);
+	void updateContentSource();
+	void updateShowing();
+	void releaseShowing();
+
+	void destroyHoldTexture();
 
 	obs_display_t *display_ = nullptr;
-	obs_source_t *labelSource_ = nullptr;
-	gs_texture_t *placeholderTexture_ = nullptr;
-	int placeholderTexSize_ = 0;
-	gs_texture_t *labelBgTexture_ = nullptr;
-	int labelBgTexW_ = 0;
-	int labelBgTexH_ = 0;
-	QColor labelBgTexColor_;
-	QString placeholderSvgPath_;
+	uint32_t displayW_ = 0; // Swap chain size last requested
+	uint32_t displayH_ = 0;
+
+	// UI thread state, published to the graphics thread by publishState()
 	CellConfig config_;
+	uint64_t configGeneration_ = 0;
+	LabelText label_;
+	LabelText labelPrev_;
+	QString labelExpanded_; // Text and font label_ was built from
+	QString labelFontDesc_;
+	QString placeholderSvgPath_;
+	SourceRef tokenSource_; // Content source as seen by label tokens
+	bool visible_ = true;
+
+	std::atomic<const RenderState *> state_{nullptr};
+	QVector<RetiredState> retired_; // Replaced snapshots not yet freed (UI thread)
+
+	// Graphics thread copy of the state being drawn and the config edit
+	// last applied from it
+	const RenderState *drawState_ = nullptr;
+	uint64_t appliedGeneration_ = 0;
+	SourceRef contentSource_; // Resolves drawState_->contentName
+
+	// Last source this cell drew a live frame of; its cached texture is
+	// shown (marked stale) while the source is missing or restarting
+	obs_weak_source_t *lastGoodSource_ = nullptr;
+	obs_weak_source_t *showingSource_ = nullptr; // Source we hold a show reference on
 	QWidget *surface_ = nullptr;
 
-	// EBU R 95 safe area vertex buffers (normalized 0-1 coordinates)
-	gs_vertbuffer_t *actionSafeVb_ = nullptr;
-	gs_vertbuffer_t *graphicsSafeVb_ = nullptr;
-	gs_vertbuffer_t *fourByThreeSafeVb_ = nullptr;
-	gs_vertbuffer_t *leftLineVb_ = nullptr;
-	gs_vertbuffer_t *topLineVb_ = nullptr;
-	gs_vertbuffer_t *rightLineVb_ = nullptr;
+	// Last content render for cells with an update rate or resolution
+	// budget; reused between updates and drawn stretched over the cell.
+	// Static cells (placeholders) keep their whole render, label included,
+	// here until the config or cell size changes or the label arrives.
+	gs_texrender_t *holdTexrender_ = nullptr;
+	uint32_t holdTexW_ = 0;
+	uint32_t holdTexH_ = 0;
+	QString holdLabelKey_;     // Label drawn into the static render, if any
+	uint64_t holdImageId_ = 0; // ImageCache id of the image drawn into it
+	uint64_t holdUpdateNs_ = 0;
+	bool holdValid_ = false;
+	uint32_t governorPhase_ = 0; // Round-robin slot when throttled by RenderGovernor
+
+	// Top-left of the cell within the display it is being drawn into
+	int originX_ = 0;
+	int originY_ = 0;
+
+	// Size of the content drawn by the last content render (0 = nothing)
+	// and whether it was a held frame; overlays are placed from these so
+	// they stay at full resolution for budgeted cells
+	uint32_t contentW_ = 0;
+	uint32_t contentH_ = 0;
+	bool contentStale_ = false;
+
+	// Overlay batch for this cell's own display and its static render
+	OverlayBatcher overlay_;
 };
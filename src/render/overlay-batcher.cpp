@@ -0,0 +1,332 @@
+/*
+OBS Looking Glass - Custom Dynamic Multiview Plugin
+Copyright (C) 2025
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#include "overlay-batcher.hpp"
+#include "gpu-release-queue.hpp"
+#include "../plugin.hpp"
+
+#include <obs-module.h>
+#include <graphics/vec2.h>
+#include <graphics/vec3.h>
+#include <graphics/vec4.h>
+
+#include <algorithm>
+
+// Initial vertex buffer size; grows by doubling (6 vertices per shape)
+#define INITIAL_CAPACITY 1536
+
+// Shared by every batcher; loaded on first flush
+static gs_effect_t *s_overlayEffect = nullptr;
+static bool s_overlayEffectFailed = false;
+
+static gs_effect_t *GetOverlayEffect()
+{
+	if (s_overlayEffect || s_overlayEffectFailed)
+		return s_overlayEffect;
+
+	char *path = obs_module_file("effects/overlay.effect");
+	char *errors = nullptr;
+	s_overlayEffect = path ? gs_effect_create_from_file(path, &errors) : nullptr;
+	if (!s_overlayEffect) {
+		obs_log(LOG_ERROR, "failed to load overlay effect: %s", errors ? errors : "file not found");
+		s_overlayEffectFailed = true;
+	}
+	bfree(errors);
+	bfree(path);
+	return s_overlayEffect;
+}
+
+void OverlayBatcher::ReleaseEffect()
+{
+	if (s_overlayEffect) {
+		obs_enter_graphics();
+		gs_effect_destroy(s_overlayEffect);
+		obs_leave_graphics();
+		s_overlayEffect = nullptr;
+	}
+	s_overlayEffectFailed = false;
+}
+
+// gs_effect_set_color takes 0xAARRGGBB; vertex colors are stored as bytes
+// R, G, B, A (0xAABBGGRR on little-endian), so red and blue swap places
+static inline uint32_t ToVertexColor(uint32_t argb)
+{
+	return (argb & 0xFF00FF00) | ((argb >> 16) & 0xFF) | ((argb & 0xFF) << 16);
+}
+
+OverlayBatcher::OverlayBatcher() {}
+
+OverlayBatcher::~OverlayBatcher()
+{
+	destroy();
+}
+
+void OverlayBatcher::destroy()
+{
+	GpuReleaseQueue *queue = GetGpuReleaseQueue();
+	queue->releaseVertexBuffer(vb_);
+	queue->releaseVertexBuffer(texturedVb_);
+	vb_ = nullptr;
+	texturedVb_ = nullptr;
+	capacity_ = 0;
+	texturedCapacity_ = 0;
+	vertices_.clear();
+	textured_.clear();
+}
+
+void OverlayBatcher::addRect(float x, float y, float cx, float cy, uint32_t color)
+{
+	addRoundedRect(x, y, cx, cy, 0.0f, color);
+}
+
+void OverlayBatcher::addRoundedRect(float x, float y, float cx, float cy, float radius, uint32_t color)
+{
+	if (cx <= 0.0f || cy <= 0.0f || (color >> 24) == 0)
+		return;
+
+	float halfW = cx * 0.5f;
+	float halfH = cy * 0.5f;
+	radius = std::min(radius, std::min(halfW, halfH));
+	uint32_t vertexColor = ToVertexColor(color);
+
+	auto corner = [&](float sx, float sy) {
+		Vertex v;
+		v.x = x + halfW + sx * halfW;
+		v.y = y + halfH + sy * halfH;
+		v.color = vertexColor;
+		v.localX = sx * halfW;
+		v.localY = sy * halfH;
+		v.halfW = halfW;
+		v.halfH = halfH;
+		v.radius = radius;
+		return v;
+	};
+
+	Vertex topLeft = corner(-1.0f, -1.0f);
+	Vertex topRight = corner(1.0f, -1.0f);
+	Vertex bottomLeft = corner(-1.0f, 1.0f);
+	Vertex bottomRight = corner(1.0f, 1.0f);
+
+	vertices_.push_back(topLeft);
+	vertices_.push_back(topRight);
+	vertices_.push_back(bottomLeft);
+	vertices_.push_back(bottomLeft);
+	vertices_.push_back(topRight);
+	vertices_.push_back(bottomRight);
+}
+
+void OverlayBatcher::addFrame(float x, float y, float cx, float cy, float thickness, uint32_t color)
+{
+	if (cx <= 0.0f || cy <= 0.0f)
+		return;
+
+	thickness = std::min(thickness, std::min(cx, cy) * 0.5f);
+
+	addRect(x, y, cx, thickness, color);
+	addRect(x, y + cy - thickness, cx, thickness, color);
+	addRect(x, y + thickness, thickness, cy - 2.0f * thickness, color);
+	addRect(x + cx - thickness, y + thickness, thickness, cy - 2.0f * thickness, color);
+}
+
+void OverlayBatcher::addTexturedRect(float x, float y, float cx, float cy, gs_texture_t *texture, float u0, float v0,
+				     float u1, float v1)
+{
+	if (!texture || cx <= 0.0f || cy <= 0.0f)
+		return;
+
+	TexturedVertex topLeft = {x, y, u0, v0, texture};
+	TexturedVertex topRight = {x + cx, y, u1, v0, texture};
+	TexturedVertex bottomLeft = {x, y + cy, u0, v1, texture};
+	TexturedVertex bottomRight = {x + cx, y + cy, u1, v1, texture};
+
+	textured_.push_back(topLeft);
+	textured_.push_back(topRight);
+	textured_.push_back(bottomLeft);
+	textured_.push_back(bottomLeft);
+	textured_.push_back(topRight);
+	textured_.push_back(bottomRight);
+}
+
+void OverlayBatcher::ensureCapacity(size_t count)
+{
+	if (vb_ && count <= capacity_)
+		return;
+
+	size_t capacity = std::max(capacity_, (size_t)INITIAL_CAPACITY);
+	while (capacity < count)
+		capacity *= 2;
+
+	if (vb_)
+		gs_vertexbuffer_destroy(vb_);
+
+	struct gs_vb_data *data = gs_vbdata_create();
+	data->num = capacity;
+	data->points = (struct vec3 *)bzalloc(sizeof(struct vec3) * capacity);
+	data->colors = (uint32_t *)bzalloc(sizeof(uint32_t) * capacity);
+	data->num_tex = 2;
+	data->tvarray = (struct gs_tvertarray *)bzalloc(sizeof(struct gs_tvertarray) * 2);
+	data->tvarray[0].width = 4;
+	data->tvarray[0].array = bzalloc(sizeof(struct vec4) * capacity);
+	data->tvarray[1].width = 2;
+	data->tvarray[1].array = bzalloc(sizeof(struct vec2) * capacity);
+
+	vb_ = gs_vertexbuffer_create(data, GS_DYNAMIC);
+	capacity_ = vb_ ? capacity : 0;
+}
+
+void OverlayBatcher::ensureTexturedCapacity(size_t count)
+{
+	if (texturedVb_ && count <= texturedCapacity_)
+		return;
+
+	size_t capacity = std::max(texturedCapacity_, (size_t)INITIAL_CAPACITY);
+	while (capacity < count)
+		capacity *= 2;
+
+	if (texturedVb_)
+		gs_vertexbuffer_destroy(texturedVb_);
+
+	struct gs_vb_data *data = gs_vbdata_create();
+	data->num = capacity;
+	data->points = (struct vec3 *)bzalloc(sizeof(struct vec3) * capacity);
+	data->num_tex = 1;
+	data->tvarray = (struct gs_tvertarray *)bzalloc(sizeof(struct gs_tvertarray));
+	data->tvarray[0].width = 2;
+	data->tvarray[0].array = bzalloc(sizeof(struct vec2) * capacity);
+
+	texturedVb_ = gs_vertexbuffer_create(data, GS_DYNAMIC);
+	texturedCapacity_ = texturedVb_ ? capacity : 0;
+}
+
+void OverlayBatcher::flush(uint32_t cx, uint32_t cy)
+{
+	if (empty())
+		return;
+	if (cx == 0 || cy == 0) {
+		vertices_.clear();
+		textured_.clear();
+		return;
+	}
+
+	gs_viewport_push();
+	gs_projection_push();
+	gs_set_viewport(0, 0, cx, cy);
+	gs_ortho(0.0f, (float)cx, 0.0f, (float)cy, -100.0f, 100.0f);
+
+	gs_matrix_push();
+	gs_matrix_identity();
+
+	flushShapes();
+	flushTextured();
+
+	gs_matrix_pop();
+
+	gs_projection_pop();
+	gs_viewport_pop();
+}
+
+void OverlayBatcher::flushShapes()
+{
+	if (vertices_.empty())
+		return;
+
+	gs_effect_t *effect = GetOverlayEffect();
+	if (effect)
+		ensureCapacity(vertices_.size());
+	if (!effect || !vb_) {
+		vertices_.clear();
+		return;
+	}
+
+	struct gs_vb_data *data = gs_vertexbuffer_get_data(vb_);
+	struct vec4 *rects = (struct vec4 *)data->tvarray[0].array;
+	struct vec2 *shapes = (struct vec2 *)data->tvarray[1].array;
+	for (size_t i = 0; i < vertices_.size(); i++) {
+		const Vertex &v = vertices_[i];
+		vec3_set(&data->points[i], v.x, v.y, 0.0f);
+		data->colors[i] = v.color;
+		vec4_set(&rects[i], v.localX, v.localY, v.halfW, v.halfH);
+		vec2_set(&shapes[i], v.radius, 0.0f);
+	}
+	gs_vertexbuffer_flush(vb_);
+
+	gs_blend_state_push();
+	gs_enable_blending(true);
+	gs_blend_function(GS_BLEND_SRCALPHA, GS_BLEND_INVSRCALPHA);
+
+	gs_load_vertexbuffer(vb_);
+	gs_load_indexbuffer(nullptr);
+	while (gs_effect_loop(effect, "Draw"))
+		gs_draw(GS_TRIS, 0, (uint32_t)vertices_.size());
+	gs_load_vertexbuffer(nullptr);
+
+	gs_blend_state_pop();
+
+	vertices_.clear();
+}
+
+void OverlayBatcher::flushTextured()
+{
+	if (textured_.empty())
+		return;
+
+	ensureTexturedCapacity(textured_.size());
+	if (!texturedVb_) {
+		textured_.clear();
+		return;
+	}
+
+	struct gs_vb_data *data = gs_vertexbuffer_get_data(texturedVb_);
+	struct vec2 *uvs = (struct vec2 *)data->tvarray[0].array;
+	for (size_t i = 0; i < textured_.size(); i++) {
+		vec3_set(&data->points[i], textured_[i].x, textured_[i].y, 0.0f);
+		vec2_set(&uvs[i], textured_[i].u, textured_[i].v);
+	}
+	gs_vertexbuffer_flush(texturedVb_);
+
+	gs_blend_state_push();
+	gs_enable_blending(true);
+	gs_blend_function(GS_BLEND_ONE, GS_BLEND_INVSRCALPHA);
+
+	gs_effect_t *effect = obs_get_base_effect(OBS_EFFECT_DEFAULT);
+	gs_eparam_t *imageParam = gs_effect_get_param_by_name(effect, "image");
+
+	gs_load_vertexbuffer(texturedVb_);
+	gs_load_indexbuffer(nullptr);
+
+	// One draw per run of quads sharing a texture; labels all come from
+	// the same atlas, so in practice this is a single draw
+	size_t start = 0;
+	while (start < textured_.size()) {
+		gs_texture_t *texture = textured_[start].texture;
+		size_t end = start;
+		while (end < textured_.size() && textured_[end].texture == texture)
+			end++;
+
+		gs_effect_set_texture(imageParam, texture);
+		while (gs_effect_loop(effect, "Draw"))
+			gs_draw(GS_TRIS, (uint32_t)start, (uint32_t)(end - start));
+
+		start = end;
+	}
+	gs_load_vertexbuffer(nullptr);
+
+	gs_blend_state_pop();
+
+	textured_.clear();
+}
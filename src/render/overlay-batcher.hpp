@@ -0,0 +1,94 @@
+/*
+OBS Looking Glass - Custom Dynamic Multiview Plugin
+Copyright (C) 2025
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#pragma once
+
+#include <obs.h>
+#include <graphics/graphics.h>
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * Collects overlays for one render target and draws them in one pass.
+ * Status borders, safe-area guides, stale markers, label backgrounds and
+ * compositor grid lines are flat-colored shapes queued in target pixel
+ * coordinates while cells render and drawn with a single draw call; label
+ * text quads sampling the shared label atlas follow in a second one.
+ * Rounded corners come from the signed-distance-field effect in
+ * data/effects/overlay.effect, so no textures are rasterized or uploaded
+ * when shapes change size or color.
+ *
+ * All methods except the constructor run on the OBS graphics thread with the
+ * graphics context active.
+ */
+class OverlayBatcher {
+public:
+	OverlayBatcher();
+	~OverlayBatcher();
+
+	// Colors are 0xAARRGGBB, as for gs_effect_set_color
+	void addRect(float x, float y, float cx, float cy, uint32_t color);
+	void addRoundedRect(float x, float y, float cx, float cy, float radius, uint32_t color);
+
+	// Outline of thickness pixels drawn inside the rectangle
+	void addFrame(float x, float y, float cx, float cy, float thickness, uint32_t color);
+
+	// Premultiplied-alpha texture region, drawn after all shapes
+	void addTexturedRect(float x, float y, float cx, float cy, gs_texture_t *texture, float u0, float v0, float u1,
+			     float v1);
+
+	bool empty() const { return vertices_.empty() && textured_.empty(); }
+
+	// Draw everything queued into a cx x cy target and reset the batch
+	void flush(uint32_t cx, uint32_t cy);
+
+	// Hand the vertex buffers to the GPU release queue
+	void destroy();
+
+	// Release the shared effect at shutdown, while graphics is still up
+	static void ReleaseEffect();
+
+private:
+	struct Vertex {
+		float x, y;
+		uint32_t color; // Vertex color byte order (0xAABBGGRR)
+		float localX, localY;
+		float halfW, halfH;
+		float radius;
+	};
+
+	struct TexturedVertex {
+		float x, y;
+		float u, v;
+		gs_texture_t *texture;
+	};
+
+	void ensureCapacity(size_t count);
+	void ensureTexturedCapacity(size_t count);
+	void flushShapes();
+	void flushTextured();
+
+	std::vector<Vertex> vertices_;
+	gs_vertbuffer_t *vb_ = nullptr;
+	size_t capacity_ = 0;
+
+	std::vector<TexturedVertex> textured_;
+	gs_vertbuffer_t *texturedVb_ = nullptr;
+	size_t texturedCapacity_ = 0;
+};
@@ -0,0 +1,107 @@
+/*
+OBS Looking Glass - Custom Dynamic Multiview Plugin
+Copyright (C) 2025
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#include "render-governor.hpp"
+#include "../plugin.hpp"
+
+#include <algorithm>
+
+// Frames per evaluation window (about half a second at 60 fps)
+#define EVALUATION_FRAMES 30
+
+// Highest level: non-tally cells update every 8th frame
+#define MAX_THROTTLE_LEVEL 3
+
+// Consecutive windows with headroom required before stepping back down
+#define HEADROOM_WINDOWS 4
+
+// Frame time thresholds as a fraction of the frame interval
+#define OVER_BUDGET_RATIO 0.9
+#define HEADROOM_RATIO 0.6
+
+// Throttling only helps if the multiview itself is a meaningful part of
+// the frame; below this share of the interval the load is elsewhere
+#define MIN_PLUGIN_SHARE 0.05
+
+RenderGovernor::RenderGovernor()
+{
+	lastLagged_ = obs_get_lagged_frames();
+	video_t *video = obs_get_video();
+	lastSkipped_ = video ? video_output_get_skipped_frames(video) : 0;
+
+	obs_add_tick_callback(TickCallback, this);
+}
+
+RenderGovernor::~RenderGovernor()
+{
+	obs_remove_tick_callback(TickCallback, this);
+}
+
+void RenderGovernor::TickCallback(void *data, float)
+{
+	auto *self = (RenderGovernor *)data;
+	if (++self->windowFrames_ >= EVALUATION_FRAMES)
+		self->evaluate();
+}
+
+void RenderGovernor::evaluate()
+{
+	uint64_t interval = obs_get_frame_interval_ns();
+	if (interval == 0)
+		return;
+
+	uint32_t lagged = obs_get_lagged_frames();
+	video_t *video = obs_get_video();
+	uint32_t skipped = video ? video_output_get_skipped_frames(video) : lastSkipped_;
+	bool droppedFrames = lagged != lastLagged_ || skipped != lastSkipped_;
+	lastLagged_ = lagged;
+	lastSkipped_ = skipped;
+
+	double frameRatio = (double)obs_get_average_frame_time_ns() / (double)interval;
+	double pluginShare = (double)drawNs_ / (double)windowFrames_ / (double)interval;
+	drawNs_ = 0;
+	windowFrames_ = 0;
+
+	uint32_t level = level_.load(std::memory_order_relaxed);
+	uint32_t newLevel = level;
+
+	bool overBudget = (droppedFrames || frameRatio > OVER_BUDGET_RATIO) && pluginShare >= MIN_PLUGIN_SHARE;
+	if (overBudget) {
+		headroomWindows_ = 0;
+		newLevel = std::min<uint32_t>(level + 1, MAX_THROTTLE_LEVEL);
+	} else if (!droppedFrames && frameRatio < HEADROOM_RATIO) {
+		if (level > 0 && ++headroomWindows_ >= HEADROOM_WINDOWS) {
+			headroomWindows_ = 0;
+			newLevel = level - 1;
+		}
+	} else {
+		headroomWindows_ = 0;
+	}
+
+	if (newLevel != level) {
+		level_.store(newLevel, std::memory_order_release);
+		obs_log(LOG_INFO, "render governor: throttle level %u -> %u (frame time %.0f%%, multiview %.0f%%)", level,
+			newLevel, frameRatio * 100.0, pluginShare * 100.0);
+	}
+}
+
+bool RenderGovernor::shouldUpdate(uint32_t phase, uint64_t frame) const
+{
+	uint32_t div = divisor();
+	return div <= 1 || (frame + phase) % div == 0;
+}
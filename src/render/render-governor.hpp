@@ -0,0 +1,66 @@
+/*
+OBS Looking Glass - Custom Dynamic Multiview Plugin
+Copyright (C) 2025
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#pragma once
+
+#include <obs.h>
+
+#include <atomic>
+#include <cstdint>
+
+/**
+ * Adaptive render governor shared by all multiview cells.
+ * Once per evaluation window it compares OBS render timing (average frame
+ * time and lagged/skipped frame counters) and the plugin's own draw time
+ * against the frame budget. While over budget it raises a throttle level
+ * that lowers the update rate of non-tally cells by a power of two, with
+ * each cell updating on its own phase so the work is spread round-robin
+ * across frames. The level drops again once there is sustained headroom.
+ * Cells currently on program or preview are never throttled.
+ */
+class RenderGovernor {
+public:
+	RenderGovernor();
+	~RenderGovernor();
+
+	// Report time spent in a cell draw (graphics thread)
+	void addDrawTime(uint64_t ns) { drawNs_ += ns; }
+
+	// Round-robin slot for a newly created renderer
+	uint32_t nextPhase() { return nextPhase_.fetch_add(1, std::memory_order_relaxed); }
+
+	// Update every Nth frame; 1 means no throttling
+	uint32_t divisor() const { return 1u << level_.load(std::memory_order_acquire); }
+
+	// Whether a throttled cell with this phase should update this frame
+	bool shouldUpdate(uint32_t phase, uint64_t frame) const;
+
+private:
+	static void TickCallback(void *data, float seconds);
+	void evaluate();
+
+	std::atomic<uint32_t> level_{0};
+	std::atomic<uint32_t> nextPhase_{0};
+
+	// Graphics thread only
+	uint64_t drawNs_ = 0;
+	uint32_t windowFrames_ = 0;
+	uint32_t headroomWindows_ = 0;
+	uint32_t lastLagged_ = 0;
+	uint32_t lastSkipped_ = 0;
+};
@@ -0,0 +1,97 @@
+/*
+OBS Looking Glass - Custom Dynamic Multiview Plugin
+Copyright (C) 2025
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#include "source-resolver.hpp"
+
+#include <atomic>
+
+namespace SourceResolver {
+
+static std::atomic<uint64_t> s_generation{0};
+
+static const char *const s_signals[] = {"source_create", "source_remove", "source_destroy", "source_rename"};
+
+static void OnSourceSignal(void *, calldata_t *)
+{
+	// Signals fire on arbitrary threads; the bump is all that is needed
+	s_generation.fetch_add(1, std::memory_order_release);
+}
+
+void Initialize()
+{
+	signal_handler_t *sh = obs_get_signal_handler();
+	for (const char *signal : s_signals)
+		signal_handler_connect(sh, signal, OnSourceSignal, nullptr);
+}
+
+void Shutdown()
+{
+	signal_handler_t *sh = obs_get_signal_handler();
+	for (const char *signal : s_signals)
+		signal_handler_disconnect(sh, signal, OnSourceSignal, nullptr);
+}
+
+uint64_t Generation()
+{
+	return s_generation.load(std::memory_order_acquire);
+}
+
+} // namespace SourceResolver
+
+SourceRef::~SourceRef()
+{
+	reset();
+}
+
+void SourceRef::setName(const QString &name)
+{
+	QByteArray utf8 = name.toUtf8();
+	if (utf8 == name_)
+		return;
+	reset();
+	name_ = utf8;
+}
+
+void SourceRef::reset()
+{
+	obs_weak_source_release(weak_);
+	weak_ = nullptr;
+	generation_ = UINT64_MAX;
+}
+
+obs_source_t *SourceRef::get()
+{
+	if (name_.isEmpty())
+		return nullptr;
+
+	uint64_t generation = SourceResolver::Generation();
+	if (generation != generation_) {
+		// Something was created, removed or renamed since the last lookup
+		obs_weak_source_release(weak_);
+		weak_ = nullptr;
+		generation_ = generation;
+
+		obs_source_t *source = obs_get_source_by_name(name_.constData());
+		if (!source)
+			return nullptr;
+		weak_ = obs_source_get_weak_source(source);
+		return source;
+	}
+
+	return weak_ ? obs_weak_source_get_source(weak_) : nullptr;
+}
@@ -0,0 +1,64 @@
+/*
+OBS Looking Glass - Custom Dynamic Multiview Plugin
+Copyright (C) 2025
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#pragma once
+
+#include <obs.h>
+
+#include <QByteArray>
+#include <QString>
+
+#include <cstdint>
+
+// Tracks global source lifetime signals so name lookups can be cached.
+// The generation counter changes whenever a source is created, removed,
+// destroyed or renamed, which is the only time a name can start or stop
+// resolving to a particular source.
+namespace SourceResolver {
+
+void Initialize();
+void Shutdown();
+uint64_t Generation();
+
+} // namespace SourceResolver
+
+/**
+ * A source referenced by name, resolved to a weak reference once and looked
+ * up again only after SourceResolver's generation changes. get() is what the
+ * render path calls every frame: an atomic load and a weak-to-strong upgrade,
+ * with no UTF-8 conversion and no global source table lookup.
+ */
+class SourceRef {
+public:
+	SourceRef() = default;
+	~SourceRef();
+
+	SourceRef(const SourceRef &) = delete;
+	SourceRef &operator=(const SourceRef &) = delete;
+
+	void setName(const QString &name);
+	void reset();
+
+	// Returns a strong reference the caller must release, or nullptr
+	obs_source_t *get();
+
+private:
+	QByteArray name_;
+	obs_weak_source_t *weak_ = nullptr;
+	uint64_t generation_ = UINT64_MAX;
+};
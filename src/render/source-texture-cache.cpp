@@ -0,0 +1,224 @@
+/*
+OBS Looking Glass - Custom Dynamic Multiview Plugin
+Copyright (C) 2025
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#include "source-texture-cache.hpp"
+#include "frame-context.hpp"
+#include "../plugin.hpp"
+
+#include <graphics/vec4.h>
+
+#include <algorithm>
+#include <cmath>
+
+// Entries not requested by any cell for this many frames are released
+#define UNUSED_ENTRY_FRAMES 120
+
+// Texture scales are quantized so small cell size changes (e.g. while a
+// window is being resized) do not reallocate the texture every frame
+#define SCALE_STEPS 16.0
+
+SourceTextureCache::SourceTextureCache() {}
+
+SourceTextureCache::~SourceTextureCache()
+{
+	clear();
+}
+
+void SourceTextureCache::DestroyEntry(Entry &entry)
+{
+	gs_texrender_destroy(entry.texrender);
+	entry.texrender = nullptr;
+	obs_weak_source_release(entry.weak);
+	entry.weak = nullptr;
+}
+
+void SourceTextureCache::clear()
+{
+	if (entries_.empty())
+		return;
+
+	obs_enter_graphics();
+	for (auto &it : entries_)
+		DestroyEntry(it.second);
+	obs_leave_graphics();
+	entries_.clear();
+}
+
+void SourceTextureCache::purgeUnused()
+{
+	for (auto it = entries_.begin(); it != entries_.end();) {
+		if (frame_ - it->second.requestFrame > UNUSED_ENTRY_FRAMES) {
+			DestroyEntry(it->second);
+			it = entries_.erase(it);
+		} else {
+			++it;
+		}
+	}
+}
+
+void SourceTextureCache::beginFrame()
+{
+	frame_ = GetRenderFrameContext()->frame();
+	if (lastPurgeFrame_ != frame_) {
+		lastPurgeFrame_ = frame_;
+		purgeUnused();
+	}
+}
+
+bool SourceTextureCache::HeldFrame(const Entry &entry, CachedFrame &frame)
+{
+	if (!entry.hasFrame)
+		return false;
+
+	frame.texture = gs_texrender_get_texture(entry.texrender);
+	frame.srcW = entry.srcW;
+	frame.srcH = entry.srcH;
+	frame.stale = true;
+	return frame.texture != nullptr;
+}
+
+// Whether a media source has shown nothing new since the previous frame,
+// judged by its playback position. Other async sources (cameras, capture
+// cards) always count as live: libobs has no non-consuming way to tell
+// whether they delivered a frame, and being off program (not active) says
+// nothing about that. obs_source_showing() cannot tell either, since every
+// cell drawing the source holds its own show reference.
+static bool IsIdle(obs_source_t *source, int64_t &mediaTime)
+{
+	uint32_t flags = obs_source_get_output_flags(source);
+	if (!(flags & OBS_SOURCE_ASYNC_VIDEO) || !(flags & OBS_SOURCE_CONTROLLABLE_MEDIA))
+		return false;
+
+	int64_t time = obs_source_media_get_time(source);
+	bool advanced = time != mediaTime;
+	mediaTime = time;
+	return !advanced;
+}
+
+// Paused media without filters draws the same frame every time
+static bool IsFrozen(obs_source_t *source)
+{
+	if (!(obs_source_get_output_flags(source) & OBS_SOURCE_CONTROLLABLE_MEDIA))
+		return false;
+	return obs_source_media_get_state(source) == OBS_MEDIA_STATE_PAUSED && obs_source_filter_count(source) == 0;
+}
+
+bool SourceTextureCache::render(obs_source_t *source, uint32_t cx, uint32_t cy, CachedFrame &frame)
+{
+	if (!source)
+		return false;
+
+	beginFrame();
+
+	obs_weak_source_t *weak = obs_source_get_weak_source(source);
+	auto it = entries_.find(weak);
+	if (it == entries_.end()) {
+		it = entries_.emplace(weak, Entry()).first;
+		it->second.weak = weak;
+	} else {
+		obs_weak_source_release(weak);
+	}
+	Entry &entry = it->second;
+
+	if (!entry.texrender)
+		entry.texrender = gs_texrender_create(GS_RGBA, GS_ZS_NONE);
+
+	// Track the largest size requested this frame; the previous frame's
+	// maximum decides the texture size so every cell converges on one
+	// texture large enough for all of them.
+	if (entry.requestFrame != frame_) {
+		entry.prevWantCx = entry.wantCx;
+		entry.prevWantCy = entry.wantCy;
+		entry.wantCx = 0;
+		entry.wantCy = 0;
+		entry.requestFrame = frame_;
+	}
+	entry.wantCx = std::max(entry.wantCx, cx);
+	entry.wantCy = std::max(entry.wantCy, cy);
+
+	uint32_t srcW = obs_source_get_width(source);
+	uint32_t srcH = obs_source_get_height(source);
+
+	// Idleness is decided once per frame, on the first request, so the
+	// media position is compared tick to tick
+	if (entry.checkedFrame != frame_) {
+		entry.checkedFrame = frame_;
+		entry.idle = IsIdle(source, entry.mediaTime);
+	}
+
+	// Sources restarting (zero size) or idle keep their last frame
+	if (srcW == 0 || srcH == 0 || (entry.hasFrame && entry.idle))
+		return HeldFrame(entry, frame);
+
+	if (entry.renderedFrame != frame_) {
+		uint32_t wantCx = std::max(entry.wantCx, entry.prevWantCx);
+		uint32_t wantCy = std::max(entry.wantCy, entry.prevWantCy);
+		double scale = std::max((double)wantCx / (double)srcW, (double)wantCy / (double)srcH);
+		scale = std::min(1.0, std::ceil(scale * SCALE_STEPS) / SCALE_STEPS);
+		uint32_t texW = std::max(1u, (uint32_t)std::ceil(srcW * scale));
+		uint32_t texH = std::max(1u, (uint32_t)std::ceil(srcH * scale));
+
+		bool reuse = entry.hasFrame && entry.srcW == srcW && entry.srcH == srcH && entry.texW == texW &&
+			     entry.texH == texH && IsFrozen(source);
+
+		if (!reuse) {
+			gs_texrender_reset(entry.texrender);
+			if (gs_texrender_begin(entry.texrender, texW, texH)) {
+				struct vec4 clearColor;
+				vec4_zero(&clearColor);
+				gs_clear(GS_CLEAR_COLOR, &clearColor, 0.0f, 0);
+				gs_ortho(0.0f, (float)srcW, 0.0f, (float)srcH, -100.0f, 100.0f);
+
+				obs_source_video_render(source);
+
+				gs_texrender_end(entry.texrender);
+				entry.hasFrame = true;
+				entry.srcW = srcW;
+				entry.srcH = srcH;
+				entry.texW = texW;
+				entry.texH = texH;
+			}
+		}
+		entry.renderedFrame = frame_;
+	}
+
+	if (!entry.hasFrame)
+		return false;
+
+	frame.texture = gs_texrender_get_texture(entry.texrender);
+	frame.srcW = entry.srcW;
+	frame.srcH = entry.srcH;
+	frame.stale = false;
+	return frame.texture != nullptr;
+}
+
+bool SourceTextureCache::held(obs_weak_source_t *weak, CachedFrame &frame)
+{
+	if (!weak)
+		return false;
+
+	beginFrame();
+
+	auto it = entries_.find(weak);
+	if (it == entries_.end())
+		return false;
+
+	// Keep the entry alive while a cell is still showing its last frame
+	it->second.requestFrame = frame_;
+	return HeldFrame(it->second, frame);
+}
@@ -0,0 +1,97 @@
+/*
+OBS Looking Glass - Custom Dynamic Multiview Plugin
+Copyright (C) 2025
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program. If not, see <https://www.gnu.org/licenses/>
+*/
+
+#pragma once
+
+#include <obs.h>
+#include <graphics/graphics.h>
+
+#include <cstdint>
+#include <unordered_map>
+
+/**
+ * Process-wide cache of scene/source renders shared by every cell in every
+ * multiview window. Each referenced source is rendered at most once per OBS
+ * frame into a gs_texrender_t; all cells showing that source draw from the
+ * same texture. Textures are sized to the largest cell that requested the
+ * source in the previous frame, so a single small tile does not pay for a
+ * full base-resolution render.
+ *
+ * Entries are keyed by the source's weak reference, which stays unique for
+ * as long as the entry holds it. A cell can therefore keep drawing the last
+ * frame of a source that went idle, lost its size or was destroyed, and no
+ * new render is attempted while the source has nothing new to show.
+ *
+ * All methods except the constructor and destructor run on the OBS graphics
+ * thread with the graphics context active (i.e. from draw callbacks).
+ */
+class SourceTextureCache {
+public:
+	SourceTextureCache();
+	~SourceTextureCache();
+
+	struct CachedFrame {
+		gs_texture_t *texture = nullptr;
+		uint32_t srcW = 0; // Source size the texture was rendered from
+		uint32_t srcH = 0;
+		bool stale = false; // Held from an earlier frame; the source is idle
+	};
+
+	// Fills frame with this frame's render of source, rendering it first if
+	// no other cell has done so yet. cx/cy is the pixel size the caller will
+	// draw it at. Media sources whose position did not advance and
+	// zero-size sources return their last render marked stale. Returns
+	// false if there is nothing to draw.
+	bool render(obs_source_t *source, uint32_t cx, uint32_t cy, CachedFrame &frame);
+
+	// Last render of the source behind weak, even if it has been destroyed
+	// since. Always marked stale. Returns false if it is no longer cached.
+	bool held(obs_weak_source_t *weak, CachedFrame &frame);
+
+	// Destroy all cached textures. Only call when no display is drawing.
+	void clear();
+
+private:
+	struct Entry {
+		obs_weak_source_t *weak = nullptr;
+		gs_texrender_t *texrender = nullptr;
+		bool hasFrame = false;
+		uint32_t srcW = 0;
+		uint32_t srcH = 0;
+		uint32_t texW = 0;
+		uint32_t texH = 0;
+		uint64_t renderedFrame = UINT64_MAX;
+		uint64_t requestFrame = UINT64_MAX;
+		uint64_t checkedFrame = UINT64_MAX;
+		bool idle = false;
+		int64_t mediaTime = -1; // Media position at the last check
+		uint32_t wantCx = 0;
+		uint32_t wantCy = 0;
+		uint32_t prevWantCx = 0;
+		uint32_t prevWantCy = 0;
+	};
+
+	void beginFrame();
+	void purgeUnused();
+	static bool HeldFrame(const Entry &entry, CachedFrame &frame);
+	static void DestroyEntry(Entry &entry);
+
+	std::unordered_map<obs_weak_source_t *, Entry> entries_;
+	uint64_t frame_ = 0;
+	uint64_t lastPurgeFrame_ = UINT64_MAX;
+};
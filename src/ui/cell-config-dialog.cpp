@@ -31,6 +31,7 @@ with this program. If not, see <https://www.gnu.org/licenses/>
 #include <QFontDialog>
 #include <QFontDatabase>
 #include <QColorDialog>
+#include <QFileDialog>
 
 #include <algorithm>
 
@@ -73,6 +74,19 @@ CellConfigDialog::CellConfigDialog(const WidgetConfig &current, QWidget *parent)
 	subtypeLabel_ = new QLabel(LG_TEXT("CellDialog.Selection"));
 	typeLayout->addRow(subtypeLabel_, subtypeCombo_);
 
+	// Custom image for placeholder cells; empty uses the default icon
+	imageRow_ = new QWidget();
+	auto *imageLayout = new QHBoxLayout(imageRow_);
+	imageLayout->setContentsMargins(0, 0, 0, 0);
+	imagePathEdit_ = new QLineEdit(config_.placeholderPath);
+	imagePathEdit_->setPlaceholderText(LG_TEXT("CellDialog.ImageDefault"));
+	auto *imageBtn = new QPushButton(LG_TEXT("CellDialog.ImageBrowse"));
+	imageLayout->addWidget(imagePathEdit_, 1);
+	imageLayout->addWidget(imageBtn);
+	imageLabel_ = new QLabel(LG_TEXT("CellDialog.Image"));
+	typeLayout->addRow(imageLabel_, imageRow_);
+	connect(imageBtn, &QPushButton::clicked, this, &CellConfigDialog::onChooseImage);
+
 	safeRegionCheck_ = new QCheckBox(LG_TEXT("CellDialog.SafeRegion"));
 	safeRegionCheck_->setChecked(config_.safeRegion);
 	safeRegionCheck_->setToolTip(LG_TEXT("CellDialog.SafeRegionTooltip"));
@@ -83,6 +97,22 @@ CellConfigDialog::CellConfigDialog(const WidgetConfig &current, QWidget *parent)
 	showStatusCheck_->setToolTip(LG_TEXT("CellDialog.ShowStatusTooltip"));
 	typeLayout->addRow(showStatusCheck_);
 
+	// Render budgets for low-priority tiles
+	updateRateCombo_ = new QComboBox();
+	updateRateCombo_->addItem(LG_TEXT("CellDialog.UpdateRateFull"), 0);
+	for (int fps : {60, 30, 15, 5})
+		updateRateCombo_->addItem(QString(LG_TEXT("CellDialog.UpdateRateFps")).arg(fps), fps);
+	updateRateCombo_->setToolTip(LG_TEXT("CellDialog.UpdateRateTooltip"));
+	updateRateLabel_ = new QLabel(LG_TEXT("CellDialog.UpdateRate"));
+	typeLayout->addRow(updateRateLabel_, updateRateCombo_);
+
+	renderScaleCombo_ = new QComboBox();
+	for (int percent : {100, 75, 50, 25})
+		renderScaleCombo_->addItem(QString("%1%").arg(percent), percent);
+	renderScaleCombo_->setToolTip(LG_TEXT("CellDialog.RenderScaleTooltip"));
+	renderScaleLabel_ = new QLabel(LG_TEXT("CellDialog.RenderScale"));
+	typeLayout->addRow(renderScaleLabel_, renderScaleCombo_);
+
 	leftLayout->addLayout(typeLayout);
 	leftLayout->addStretch();
 
@@ -98,6 +128,7 @@ CellConfigDialog::CellConfigDialog(const WidgetConfig &current, QWidget *parent)
 
 	labelTextEdit_ = new QLineEdit(config_.labelText);
 	labelTextEdit_->setPlaceholderText(LG_TEXT("CellDialog.CustomTextPlaceholder"));
+	labelTextEdit_->setToolTip(LG_TEXT("CellDialog.CustomTextTooltip"));
 	labelLayout->addRow(LG_TEXT("CellDialog.CustomText"), labelTextEdit_);
 
 	// Font selection with preview
@@ -163,6 +194,22 @@ CellConfigDialog::CellConfigDialog(const WidgetConfig &current, QWidget *parent)
 	if (vIdx >= 0)
 		labelVAlignCombo_->setCurrentIndex(vIdx);
 
+	// Values outside the presets (e.g. edited by hand) are added as-is
+	int rateIdx = updateRateCombo_->findData(config_.maxFps);
+	if (rateIdx < 0) {
+		updateRateCombo_->addItem(QString(LG_TEXT("CellDialog.UpdateRateFps")).arg(config_.maxFps),
+					  config_.maxFps);
+		rateIdx = updateRateCombo_->count() - 1;
+	}
+	updateRateCombo_->setCurrentIndex(rateIdx);
+
+	int scaleIdx = renderScaleCombo_->findData(config_.renderScale);
+	if (scaleIdx < 0) {
+		renderScaleCombo_->addItem(QString("%1%").arg(config_.renderScale), config_.renderScale);
+		scaleIdx = renderScaleCombo_->count() - 1;
+	}
+	renderScaleCombo_->setCurrentIndex(scaleIdx);
+
 	// Connect signals
 	connect(typeCombo_, QOverload<int>::of(&QComboBox::currentIndexChanged), this,
 		&CellConfigDialog::onTypeChanged);
@@ -190,10 +237,21 @@ void CellConfigDialog::updateTypeVisibility()
 	subtypeLabel_->setVisible(needsSelection);
 	subtypeCombo_->setVisible(needsSelection);
 
+	bool isPlaceholder = type == WidgetType::Placeholder;
+	imageLabel_->setVisible(isPlaceholder);
+	imageRow_->setVisible(isPlaceholder);
+
 	// Status border only applies to types that can be in preview/program
 	bool canShowStatus =
 		(/*type == WidgetType::Preview || type == WidgetType::Program ||*/ type == WidgetType::Scene);
 	showStatusCheck_->setVisible(canShowStatus);
+
+	// Budgets apply to anything that draws content
+	bool hasContent = type != WidgetType::None;
+	updateRateLabel_->setVisible(hasContent);
+	updateRateCombo_->setVisible(hasContent);
+	renderScaleLabel_->setVisible(hasContent);
+	renderScaleCombo_->setVisible(hasContent);
 }
 
 void CellConfigDialog::onChooseFont()
@@ -216,6 +274,14 @@ void CellConfigDialog::onChooseBgColor()
 	}
 }
 
+void CellConfigDialog::onChooseImage()
+{
+	QString path = QFileDialog::getOpenFileName(this, LG_TEXT("CellDialog.ChooseImage"), imagePathEdit_->text(),
+						    LG_TEXT("CellDialog.ImageFilter"));
+	if (!path.isEmpty())
+		imagePathEdit_->setText(path);
+}
+
 void CellConfigDialog::updateFontPreview()
 {
 	QString style = QFontDatabase::styleString(selectedFont_);
@@ -332,6 +398,8 @@ WidgetConfig CellConfigDialog::result() const
 	w.labelBgColor = selectedBgColor_;
 	w.safeRegion = safeRegionCheck_->isChecked();
 	w.showStatus = showStatusCheck_->isChecked();
+	w.maxFps = updateRateCombo_->currentData().toInt();
+	w.renderScale = renderScaleCombo_->currentData().toInt();
 
 	if (w.type == WidgetType::Scene)
 		w.sceneName = subtypeCombo_->currentText();
@@ -339,6 +407,8 @@ WidgetConfig CellConfigDialog::result() const
 		w.sourceName = subtypeCombo_->currentText();
 	else if (w.type == WidgetType::Canvas)
 		w.canvasName = subtypeCombo_->currentData().toString();
+	else if (w.type == WidgetType::Placeholder)
+		w.placeholderPath = imagePathEdit_->text().trimmed();
 
 	return w;
 }
@@ -31,7 +31,7 @@ with this program. If not, see <https://www.gnu.org/licenses/>
 
 /**
  * Dialog for configuring an individual cell's widget type, scene/source
- * selection, and label properties (text, font, alignment, background color, visibility).
+ * selection, placeholder image, and label properties (text, font, alignment, background color, visibility).
  */
 class CellConfigDialog : public QDialog {
 	Q_OBJECT
@@ -44,6 +44,7 @@ private slots:
 	void onTypeChanged(int index);
 	void onChooseFont();
 	void onChooseBgColor();
+	void onChooseImage();
 
 private:
 	void populateSubtypes();
@@ -57,6 +58,13 @@ private:
 	QLabel *subtypeLabel_;
 	QCheckBox *safeRegionCheck_;
 	QCheckBox *showStatusCheck_;
+	QLabel *updateRateLabel_;
+	QComboBox *updateRateCombo_;
+	QLabel *renderScaleLabel_;
+	QComboBox *renderScaleCombo_;
+	QLabel *imageLabel_;
+	QWidget *imageRow_;
+	QLineEdit *imagePathEdit_;
 
 	// Label controls (right pane)
 	QCheckBox *labelVisibleCheck_;
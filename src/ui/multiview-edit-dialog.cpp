@@ -118,6 +118,21 @@ MultiviewEditDialog::MultiviewEditDialog(const MultiviewConfig &config, bool isN
 	});
 	gridSettingsForm->addRow(LG_TEXT("EditDialog.LineColor"), lineColorBtn_);
 
+	// Single-display compositor mode
+	compositorCheck_ = new QCheckBox(LG_TEXT("EditDialog.CompositorMode"));
+	compositorCheck_->setChecked(config_.compositorMode);
+	compositorCheck_->setToolTip(LG_TEXT("EditDialog.CompositorModeTooltip"));
+	gridSettingsForm->addRow(compositorCheck_);
+
+	// Refresh interval for live label tokens
+	labelRefreshSpin_ = new QSpinBox();
+	labelRefreshSpin_->setRange(100, 10000);
+	labelRefreshSpin_->setSingleStep(100);
+	labelRefreshSpin_->setSuffix(QStringLiteral(" ms"));
+	labelRefreshSpin_->setValue(config_.labelRefreshMs);
+	labelRefreshSpin_->setToolTip(LG_TEXT("EditDialog.LabelRefreshTooltip"));
+	gridSettingsForm->addRow(LG_TEXT("EditDialog.LabelRefresh"), labelRefreshSpin_);
+
 	rightLayout->addLayout(gridSettingsForm);
 	rightLayout->addSpacing(10);
 
@@ -252,6 +267,8 @@ void MultiviewEditDialog::onConfirm()
 	config_.gridCols = gridEditor_->gridCols();
 	config_.gridBorderWidth = borderWidthSpin_->value();
 	config_.gridLineColor = gridLineColor_;
+	config_.compositorMode = compositorCheck_->isChecked();
+	config_.labelRefreshMs = labelRefreshSpin_->value();
 	config_.cells = gridEditor_->cells();
 
 	ConfigManager *cm = GetConfigManager();
@@ -343,6 +360,8 @@ MultiviewConfig MultiviewEditDialog::result() const
 	mv.gridCols = gridEditor_->gridCols();
 	mv.gridBorderWidth = borderWidthSpin_->value();
 	mv.gridLineColor = gridLineColor_;
+	mv.compositorMode = compositorCheck_->isChecked();
+	mv.labelRefreshMs = labelRefreshSpin_->value();
 	mv.cells = gridEditor_->cells();
 	return mv;
 }
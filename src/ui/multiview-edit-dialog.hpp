@@ -20,6 +20,7 @@ with this program. If not, see <https://www.gnu.org/licenses/>
 
 #include <QDialog>
 #include <QComboBox>
+#include <QCheckBox>
 #include <QLineEdit>
 #include <QSpinBox>
 #include <QPushButton>
@@ -65,6 +66,8 @@ private:
 	QSpinBox *borderWidthSpin_;
 	QPushButton *lineColorBtn_;
 	QColor gridLineColor_;
+	QCheckBox *compositorCheck_;
+	QSpinBox *labelRefreshSpin_;
 
 	MultiviewConfig config_;
 	bool isNew_;
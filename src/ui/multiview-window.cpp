@@ -28,6 +28,9 @@ with this program. If not, see <https://www.gnu.org/licenses/>
 #include <QCloseEvent>
 #include <QContextMenuEvent>
 #include <QPaintEvent>
+#include <QShowEvent>
+#include <QHideEvent>
+#include <QWindow>
 #include <QPainter>
 #include <QMenu>
 #include <QScreen>
@@ -35,12 +38,20 @@ with this program. If not, see <https://www.gnu.org/licenses/>
 #include <QApplication>
 #include <QTimer>
 
+// Quiet period after the last resize or move event before displays are
+// resized and the window state is saved
+#define RESIZE_SETTLE_MS 200
+#define RECLAIM_POLL_MS 50
+
+// Closed windows kept for reopening; each holds a swap chain per cell
+#define MAX_POOLED_WINDOWS 2
+
 QMap<QString, MultiviewWindow *> MultiviewWindow::openWindows_;
+QList<MultiviewWindow *> MultiviewWindow::pooledWindows_;
+QList<MultiviewWindow *> MultiviewWindow::retiredWindows_;
 
 MultiviewWindow::MultiviewWindow(const QString &name, QWidget *parent) : QWidget(parent, Qt::Window), name_(name)
 {
-	setAttribute(Qt::WA_DeleteOnClose);
-
 	config_ = GetConfigManager()->getMultiview(name);
 	updateTitle();
 
@@ -49,6 +60,14 @@ MultiviewWindow::MultiviewWindow(const QString &name, QWidget *parent) : QWidget
 	else
 		resize(1280, 720);
 
+	labelTimer_ = new QTimer(this);
+	connect(labelTimer_, &QTimer::timeout, this, &MultiviewWindow::refreshLabels);
+
+	settleTimer_ = new QTimer(this);
+	settleTimer_->setSingleShot(true);
+	settleTimer_->setInterval(RESIZE_SETTLE_MS);
+	connect(settleTimer_, &QTimer::timeout, this, &MultiviewWindow::onResizeSettled);
+
 	buildGrid();
 
 	if (config_.fullscreen) {
@@ -60,26 +79,113 @@ MultiviewWindow::MultiviewWindow(const QString &name, QWidget *parent) : QWidget
 	openWindows_[name] = this;
 
 	// Reload when config changes externally
-	connect(GetConfigManager(), &ConfigManager::multiviewUpdated, this, [this](const QString &updatedName) {
+	ConfigManager *cm = GetConfigManager();
+	connect(cm, &ConfigManager::multiviewUpdated, this, [this](const QString &updatedName) {
 		if (updatedName == name_ && !updatingConfig_)
 			reloadConfig();
 	});
 
-	// Mark as open
+	// A pooled window must not outlive its multiview
+	connect(cm, &ConfigManager::multiviewRemoved, this, [this](const QString &removedName) {
+		if (removedName == name_)
+			dropFromPool();
+	});
+	connect(cm, &ConfigManager::multiviewRenamed, this, [this](const QString &oldName, const QString &) {
+		if (oldName == name_)
+			dropFromPool();
+	});
+	connect(cm, &ConfigManager::multiviewsReloaded, this, [this]() {
+		if (!GetConfigManager()->hasMultiview(name_))
+			dropFromPool();
+	});
+
+	markOpen();
+}
+
+MultiviewWindow::~MultiviewWindow()
+{
+	destroyGrid();
+
+	if (openWindows_.value(name_) == this)
+		openWindows_.remove(name_);
+	pooledWindows_.removeAll(this);
+	retiredWindows_.removeAll(this);
+}
+
+void MultiviewWindow::markOpen()
+{
 	updatingConfig_ = true;
 	config_.wasOpen = true;
 	GetConfigManager()->updateMultiview(config_);
 	updatingConfig_ = false;
 }
 
-MultiviewWindow::~MultiviewWindow()
+// Closed windows are hidden rather than destroyed. Hidden, they render
+// nothing and hold no show references, but keep their native surfaces and
+// displays so reopening skips swap chain creation.
+void MultiviewWindow::recycle()
 {
-	for (CellRenderer *r : renderers_)
-		delete r;
-	renderers_.clear();
-	cellSurfaces_.clear();
+	pooledWindows_.append(this);
+	while (pooledWindows_.size() > MAX_POOLED_WINDOWS)
+		pooledWindows_.takeFirst()->retire();
+}
 
-	openWindows_.remove(name_);
+void MultiviewWindow::dropFromPool()
+{
+	if (pooledWindows_.removeAll(this) > 0)
+		retire();
+}
+
+// Deleted on the next event loop pass, or by releasePool() if that comes
+// first, e.g. when windows are closed at exit
+void MultiviewWindow::retire()
+{
+	retiredWindows_.append(this);
+	deleteLater();
+}
+
+// Deletes pooled windows and those still waiting on deleteLater(), so their
+// displays and cell renderers go before the shared caches are cleared
+void MultiviewWindow::releasePool()
+{
+	QList<MultiviewWindow *> windows = pooledWindows_ + retiredWindows_;
+	pooledWindows_.clear();
+	retiredWindows_.clear();
+	qDeleteAll(windows);
+}
+
+// Bring a pooled window back for its multiview. The config may have been
+// edited or the scene collection switched meanwhile; reloadConfig() only
+// touches the cells that differ.
+void MultiviewWindow::reopen()
+{
+	openWindows_[name_] = this;
+	reloadConfig();
+	restoreWindowState();
+	if (!fullscreen_)
+		show();
+	markOpen();
+}
+
+void MultiviewWindow::restoreWindowState()
+{
+	if (config_.fullscreen) {
+		int idx = config_.monitorId;
+		if (idx >= 0 && idx < QGuiApplication::screens().size()) {
+			setFullscreenOnMonitor(idx);
+			return;
+		}
+	}
+
+	if (fullscreen_) {
+		showNormal();
+		fullscreen_ = false;
+		updateTitle();
+	}
+	if (config_.geometry.isValid())
+		setGeometry(config_.geometry);
+	else
+		resize(1280, 720);
 }
 
 void MultiviewWindow::setMultiviewName(const QString &name)
@@ -92,8 +198,10 @@ void MultiviewWindow::setMultiviewName(const QString &name)
 
 void MultiviewWindow::reloadConfig()
 {
+	MultiviewConfig old = config_;
 	config_ = GetConfigManager()->getMultiview(name_);
-	buildGrid();
+	if (!applyConfigIncrementally(old))
+		buildGrid();
 	updateLayout();
 }
 
@@ -106,6 +214,14 @@ void MultiviewWindow::openOrFocus(const QString &name)
 		return;
 	}
 
+	for (MultiviewWindow *w : pooledWindows_) {
+		if (w->name_ == name) {
+			pooledWindows_.removeAll(w);
+			w->reopen();
+			return;
+		}
+	}
+
 	auto *w = new MultiviewWindow(name);
 	w->show();
 }
@@ -139,56 +255,247 @@ MultiviewWindow *MultiviewWindow::findByName(const QString &name)
 	return openWindows_.value(name, nullptr);
 }
 
-void MultiviewWindow::buildGrid()
+void MultiviewWindow::destroyGrid()
 {
-	// Clean up existing renderers first (must destroy displays before surfaces)
+	// Displays must be destroyed before the renderers they draw and the
+	// surfaces they present to
+	delete compositor_;
+	compositor_ = nullptr;
 	for (CellRenderer *r : renderers_)
 		delete r;
 	renderers_.clear();
 	for (QWidget *s : cellSurfaces_)
 		delete s;
 	cellSurfaces_.clear();
+	delete compositorSurface_;
+	compositorSurface_ = nullptr;
+}
+
+void MultiviewWindow::buildGrid()
+{
+	// Clean up existing renderers first (must destroy displays before surfaces)
+	destroyGrid();
 
 	// Get path to the placeholder icon
 	char *dataPath = obs_module_file("looking-glass.svg");
 	placeholderSvgPath_ = dataPath ? QString::fromUtf8(dataPath) : QString();
 	bfree(dataPath);
 
-	// Create surfaces for each cell (labels and icons are rendered by CellRenderer)
-	for (const CellConfig &cell : config_.cells) {
-		(void)cell;
-		auto *surface = new QWidget(this);
-		surface->setAttribute(Qt::WA_NativeWindow);
-		surface->setStyleSheet("background-color: transparent; border-radius: 6px;");
-		cellSurfaces_.append(surface);
-
-		// Reserve slot; actual renderer created in initRenderers() after surfaces are realized
-		renderers_.append(nullptr);
+	if (config_.compositorMode) {
+		// One surface for the whole window; cells are viewports within it
+		compositorSurface_ = new QWidget(this);
+		compositorSurface_->setAttribute(Qt::WA_NativeWindow);
+		compositorSurface_->setGeometry(rect());
+		compositor_ = new MultiviewCompositor();
+	} else {
+		// Create surfaces for each cell (labels and icons are rendered by CellRenderer)
+		for (int i = 0; i < config_.cells.size(); i++)
+			cellSurfaces_.append(createCellSurface());
 	}
 
+	// Reserve slots; actual renderers created in initRenderers() after surfaces are realized
+	renderers_.fill(nullptr, config_.cells.size());
+
 	updateLayout();
 
 	// Show all surfaces so they get valid native window handles
 	for (QWidget *s : cellSurfaces_)
 		s->show();
+	if (compositorSurface_)
+		compositorSurface_->show();
 
 	// Defer obs_display creation until native windows are realized
 	QTimer::singleShot(50, this, &MultiviewWindow::initRenderers);
 }
 
+QWidget *MultiviewWindow::createCellSurface()
+{
+	auto *surface = new QWidget(this);
+	surface->setAttribute(Qt::WA_NativeWindow);
+	surface->setStyleSheet("background-color: transparent; border-radius: 6px;");
+	return surface;
+}
+
+// Apply a config edit without tearing down the grid. Cells whose widget is
+// unchanged keep their renderer and display even if they moved, edited
+// cells are updated in place, only added cells get a new surface and only
+// removed ones lose theirs, so adding, removing, splitting or merging tiles
+// never blanks the others. Returns false when the grid has to be rebuilt
+// instead.
+bool MultiviewWindow::applyConfigIncrementally(const MultiviewConfig &old)
+{
+	if (config_.compositorMode != old.compositorMode)
+		return false;
+	if (!compositor_ && cellSurfaces_.size() != renderers_.size())
+		return false;
+
+	// Renderers from the last rebuild are not created yet
+	for (CellRenderer *r : renderers_) {
+		if (!r)
+			return false;
+	}
+
+	// Match each new cell to an old one: unchanged first, then moved
+	// (same widget), then edited in place (same position), then any
+	// renderer left over
+	int newCount = config_.cells.size();
+	int oldCount = qMin(old.cells.size(), renderers_.size());
+	QVector<int> reused(newCount, -1);
+	QVector<bool> taken(renderers_.size(), false);
+	auto claim = [&](auto matches) {
+		for (int i = 0; i < newCount; i++) {
+			if (reused[i] >= 0)
+				continue;
+			for (int j = 0; j < oldCount; j++) {
+				if (!taken[j] && matches(config_.cells[i], old.cells[j])) {
+					reused[i] = j;
+					taken[j] = true;
+					break;
+				}
+			}
+		}
+	};
+	claim([](const CellConfig &a, const CellConfig &b) { return a == b; });
+	claim([](const CellConfig &a, const CellConfig &b) { return a.widget == b.widget; });
+	claim([](const CellConfig &a, const CellConfig &b) { return a.row == b.row && a.col == b.col; });
+	claim([](const CellConfig &, const CellConfig &) { return true; });
+
+	QVector<CellRenderer *> renderers(newCount, nullptr);
+	QVector<QWidget *> surfaces;
+	QVector<QWidget *> addedSurfaces;
+	for (int i = 0; i < newCount; i++) {
+		int j = reused[i];
+		if (j >= 0) {
+			renderers[i] = renderers_[j];
+			if (config_.cells[i].widget != old.cells[j].widget)
+				renderers[i]->updateConfig(config_.cells[i]);
+			if (!compositor_)
+				surfaces.append(cellSurfaces_[j]);
+		} else if (compositor_) {
+			auto *renderer = new CellRenderer();
+			renderer->setPlaceholderSvgPath(placeholderSvgPath_);
+			renderer->setVisible(renderVisible_);
+			renderer->initComposited(config_.cells[i]);
+			renderers[i] = renderer;
+		} else {
+			// Initialized by initRenderers() once the native window exists
+			QWidget *surface = createCellSurface();
+			surfaces.append(surface);
+			addedSurfaces.append(surface);
+		}
+	}
+
+	QVector<CellRenderer *> removed;
+	QVector<QWidget *> removedSurfaces;
+	for (int j = 0; j < renderers_.size(); j++) {
+		if (taken[j])
+			continue;
+		removed.append(renderers_[j]);
+		if (!compositor_)
+			removedSurfaces.append(cellSurfaces_[j]);
+	}
+
+	renderers_ = renderers;
+	cellSurfaces_ = surfaces;
+
+	// The compositor may still be drawing removed renderers this frame
+	updateLayout();
+	retireRenderers(removed);
+	for (QWidget *s : removedSurfaces)
+		delete s;
+
+	for (QWidget *s : addedSurfaces)
+		s->show();
+	if (!addedSurfaces.isEmpty())
+		QTimer::singleShot(50, this, &MultiviewWindow::initRenderers);
+
+	updateLabelTimer();
+	update();
+	return true;
+}
+
+// Renderers leaving a compositor are freed once no draw can reach them
+void MultiviewWindow::retireRenderers(const QVector<CellRenderer *> &renderers)
+{
+	if (!compositor_) {
+		for (CellRenderer *r : renderers)
+			delete r;
+		return;
+	}
+	compositor_->retireRenderers(renderers);
+	QTimer::singleShot(RECLAIM_POLL_MS, this, [this]() {
+		if (compositor_ && compositor_->reclaim())
+			retireRenderers({});
+	});
+}
+
 void MultiviewWindow::initRenderers()
 {
-	for (int i = 0; i < config_.cells.size() && i < cellSurfaces_.size(); i++) {
-		if (renderers_[i]) {
-			delete renderers_[i];
-			renderers_[i] = nullptr;
+	if (compositor_) {
+		// Stop drawing any renderers about to be replaced
+		compositor_->clearLayout();
+		QVector<CellRenderer *> replaced;
+		for (int i = 0; i < config_.cells.size() && i < renderers_.size(); i++) {
+			replaced.append(renderers_[i]);
+
+			auto *renderer = new CellRenderer();
+			renderer->setPlaceholderSvgPath(placeholderSvgPath_);
+			renderer->setVisible(renderVisible_);
+			renderer->initComposited(config_.cells[i]);
+			renderers_[i] = renderer;
 		}
+		retireRenderers(replaced);
+		compositor_->setEnabled(renderVisible_);
+		compositor_->init(compositorSurface_);
+
+		// Hand the new renderers to the compositor
+		updateLayout();
+		updateLabelTimer();
+		return;
+	}
+
+	// Only cells without a renderer: all of them after a rebuild, or the
+	// ones added by an incremental config change
+	for (int i = 0; i < config_.cells.size() && i < cellSurfaces_.size(); i++) {
+		if (renderers_[i])
+			continue;
 
 		auto *renderer = new CellRenderer();
 		renderer->setPlaceholderSvgPath(placeholderSvgPath_);
+		renderer->setVisible(renderVisible_);
 		renderer->init(cellSurfaces_[i], config_.cells[i]);
 		renderers_[i] = renderer;
 	}
+	updateLabelTimer();
+}
+
+// Only cells whose label text contains tokens are re-expanded, and each
+// one is re-laid out only if its expanded text changed
+void MultiviewWindow::updateLabelTimer()
+{
+	bool live = false;
+	for (CellRenderer *r : renderers_) {
+		if (r && r->hasLabelTokens()) {
+			live = true;
+			break;
+		}
+	}
+
+	if (live && renderVisible_) {
+		labelTimer_->setInterval(config_.labelRefreshMs);
+		if (!labelTimer_->isActive())
+			labelTimer_->start();
+	} else {
+		labelTimer_->stop();
+	}
+}
+
+void MultiviewWindow::refreshLabels()
+{
+	for (CellRenderer *r : renderers_) {
+		if (r && r->hasLabelTokens())
+			r->refreshLabel();
+	}
 }
 
 void MultiviewWindow::calculateGridMetrics(int &gridW, int &gridH, int &offsetX, int &offsetY, float &cellW,
@@ -238,7 +545,10 @@ void MultiviewWindow::calculateGridMetrics(int &gridW, int &gridH, int &offsetX,
 	offsetY = (totalH - gridH) / 2;
 }
 
-void MultiviewWindow::updateLayout()
+// During a live resize only the native surfaces follow the window; their
+// displays keep the old swap chain size and are stretched by the platform
+// until onResizeSettled() resizes them once
+void MultiviewWindow::updateLayout(bool liveResize)
 {
 	if (config_.gridRows <= 0 || config_.gridCols <= 0)
 		return;
@@ -263,7 +573,11 @@ void MultiviewWindow::updateLayout()
 	int border = config_.gridBorderWidth;
 	int inset = border > 0 ? qMax(1, border / 2) : 0;
 
-	for (int i = 0; i < config_.cells.size() && i < cellSurfaces_.size(); i++) {
+	// In compositor mode the same rectangles become viewports of the
+	// shared display rather than child window geometry
+	QVector<MultiviewCompositor::CellSlot> cellSlots;
+
+	for (int i = 0; i < config_.cells.size(); i++) {
 		const CellConfig &cell = config_.cells[i];
 		// Compute each cell's pixel boundaries by rounding individually.
 		// This distributes fractional remainders evenly across cells
@@ -282,11 +596,31 @@ void MultiviewWindow::updateLayout()
 		if (h < 1)
 			h = 1;
 
+		if (compositor_) {
+			MultiviewCompositor::CellSlot slot;
+			slot.renderer = i < renderers_.size() ? renderers_[i] : nullptr;
+			slot.rect = QRect(x, y, w, h);
+			cellSlots.append(slot);
+			continue;
+		}
+
+		if (i >= cellSurfaces_.size())
+			break;
 		cellSurfaces_[i]->setGeometry(x, y, w, h);
-		if (i < renderers_.size() && renderers_[i])
+		if (!liveResize && i < renderers_.size() && renderers_[i])
 			renderers_[i]->resize(w, h);
 	}
 
+	if (compositor_) {
+		compositorSurface_->setGeometry(rect());
+		// The whole old frame stretches, so the old layout still fits it
+		if (liveResize)
+			return;
+		compositor_->resize(width(), height());
+		compositor_->setLayout(cellSlots, gridLineRects(), config_.gridLineColor);
+		return;
+	}
+
 	// Trigger repaint for grid borders
 	update();
 }
@@ -294,29 +628,100 @@ void MultiviewWindow::updateLayout()
 void MultiviewWindow::resizeEvent(QResizeEvent *event)
 {
 	QWidget::resizeEvent(event);
-	updateLayout();
+	updateLayout(true);
+	resizePending_ = true;
+	settleTimer_->start();
+}
+
+void MultiviewWindow::onResizeSettled()
+{
+	if (resizePending_) {
+		resizePending_ = false;
+		updateLayout();
+	}
 	saveWindowState();
 }
 
 void MultiviewWindow::moveEvent(QMoveEvent *event)
 {
 	QWidget::moveEvent(event);
-	saveWindowState();
+	settleTimer_->start();
 }
 
 void MultiviewWindow::closeEvent(QCloseEvent *event)
 {
+	// Fold an unsaved resize or move into the final save
+	if (settleTimer_->isActive()) {
+		settleTimer_->stop();
+		captureWindowState();
+	}
+
 	updatingConfig_ = true;
 	config_.wasOpen = false;
 	GetConfigManager()->updateMultiview(config_);
 	updatingConfig_ = false;
 	QWidget::closeEvent(event);
+
+	if (event->isAccepted()) {
+		openWindows_.remove(name_);
+		recycle();
+	}
+}
+
+void MultiviewWindow::showEvent(QShowEvent *event)
+{
+	QWidget::showEvent(event);
+
+	// The native window exists from the first show; watch it for expose
+	// changes, which is how platforms report occlusion
+	if (!visibilityHooked_ && windowHandle()) {
+		windowHandle()->installEventFilter(this);
+		connect(windowHandle(), &QWindow::visibilityChanged, this,
+			[this](QWindow::Visibility) { updateRenderVisibility(); });
+		visibilityHooked_ = true;
+	}
+	updateRenderVisibility();
+}
+
+void MultiviewWindow::hideEvent(QHideEvent *event)
+{
+	QWidget::hideEvent(event);
+	updateRenderVisibility();
+}
+
+bool MultiviewWindow::eventFilter(QObject *watched, QEvent *event)
+{
+	if (watched == windowHandle() && event->type() == QEvent::Expose)
+		updateRenderVisibility();
+	return QWidget::eventFilter(watched, event);
+}
+
+void MultiviewWindow::updateRenderVisibility()
+{
+	QWindow *window = windowHandle();
+	bool visible = isVisible() && !isMinimized() && (!window || window->isExposed());
+	if (visible == renderVisible_)
+		return;
+
+	renderVisible_ = visible;
+	for (CellRenderer *r : renderers_) {
+		if (r)
+			r->setVisible(visible);
+	}
+	if (compositor_)
+		compositor_->setEnabled(visible);
+
+	// Catch up on labels that went stale while hidden
+	if (visible)
+		refreshLabels();
+	updateLabelTimer();
 }
 
 void MultiviewWindow::changeEvent(QEvent *event)
 {
 	QWidget::changeEvent(event);
 	if (event->type() == QEvent::WindowStateChange) {
+		updateRenderVisibility();
 		bool nowFullscreen = windowState() & Qt::WindowFullScreen;
 		if (nowFullscreen != fullscreen_) {
 			fullscreen_ = nowFullscreen;
@@ -352,7 +757,7 @@ void MultiviewWindow::contextMenuEvent(QContextMenuEvent *event)
 	menu.exec(event->globalPos());
 }
 
-void MultiviewWindow::saveWindowState()
+void MultiviewWindow::captureWindowState()
 {
 	if (!fullscreen_)
 		config_.geometry = geometry();
@@ -364,6 +769,11 @@ void MultiviewWindow::saveWindowState()
 		int idx = QGuiApplication::screens().indexOf(screen);
 		config_.monitorId = idx;
 	}
+}
+
+void MultiviewWindow::saveWindowState()
+{
+	captureWindowState();
 
 	updatingConfig_ = true;
 	GetConfigManager()->updateMultiview(config_);
@@ -420,18 +830,12 @@ void MultiviewWindow::updateTitle()
 	setWindowTitle(title);
 }
 
-void MultiviewWindow::paintEvent(QPaintEvent *event)
+QVector<QRect> MultiviewWindow::gridLineRects() const
 {
-	QWidget::paintEvent(event);
+	QVector<QRect> lines;
 
 	if (config_.gridRows <= 0 || config_.gridCols <= 0)
-		return;
-
-	QPainter painter(this);
-	painter.setRenderHint(QPainter::Antialiasing, false);
-
-	// Fill background with black
-	painter.fillRect(rect(), Qt::black);
+		return lines;
 
 	// Build ownership map: which cell index owns each grid position
 	// -1 means no cell owns it (shouldn't happen in valid config)
@@ -445,17 +849,17 @@ void MultiviewWindow::paintEvent(QPaintEvent *event)
 		}
 	}
 
-	// Use fillRect instead of pen-based drawLine for grid lines.
+	// Lines are exact pixel rectangles rather than pen strokes.
 	// QPainter::drawLine with even pen widths shifts the extra pixel to
 	// one side, causing a 1-pixel asymmetry between the left and right
-	// (or top and bottom) gaps around each cell. fillRect specifies the
-	// exact pixel rectangle, eliminating the pen-centering ambiguity.
+	// (or top and bottom) gaps around each cell. Explicit rectangles
+	// eliminate the pen-centering ambiguity and can be drawn on the GPU
+	// unchanged in compositor mode.
 	int border = config_.gridBorderWidth;
 	int inset = border > 0 ? qMax(1, border / 2) : 0;
 	int lineThick = 2 * inset; // line thickness in pixels
-	QColor lineColor = config_.gridLineColor;
 
-	// Draw vertical lines - only where there's a cell boundary
+	// Vertical lines - only where there's a cell boundary
 	// A vertical line at column 'col' should be drawn between row positions
 	// only if the cells on either side are different
 	for (int col = 0; col <= config_.gridCols; col++) {
@@ -464,7 +868,7 @@ void MultiviewWindow::paintEvent(QPaintEvent *event)
 
 		// For edge lines (col 0 and col == gridCols), always draw full line
 		if (col == 0 || col == config_.gridCols) {
-			painter.fillRect(lineX, gridOffsetY_ - inset, lineThick, gridHeight_ + 2 * inset, lineColor);
+			lines.append(QRect(lineX, gridOffsetY_ - inset, lineThick, gridHeight_ + 2 * inset));
 			continue;
 		}
 
@@ -485,7 +889,7 @@ void MultiviewWindow::paintEvent(QPaintEvent *event)
 				int endPixel = qRound(row * cellHeight_);
 				int y1 = gridOffsetY_ + startPixel - inset;
 				int segH = (endPixel - startPixel) + 2 * inset;
-				painter.fillRect(lineX, y1, lineThick, segH, lineColor);
+				lines.append(QRect(lineX, y1, lineThick, segH));
 				segmentStart = -1;
 			}
 		}
@@ -494,18 +898,18 @@ void MultiviewWindow::paintEvent(QPaintEvent *event)
 			int startPixel = qRound(segmentStart * cellHeight_);
 			int y1 = gridOffsetY_ + startPixel - inset;
 			int segH = (gridHeight_ - startPixel) + 2 * inset;
-			painter.fillRect(lineX, y1, lineThick, segH, lineColor);
+			lines.append(QRect(lineX, y1, lineThick, segH));
 		}
 	}
 
-	// Draw horizontal lines - only where there's a cell boundary
+	// Horizontal lines - only where there's a cell boundary
 	for (int row = 0; row <= config_.gridRows; row++) {
 		int rowPixel = qRound(row * cellHeight_);
 		int lineY = gridOffsetY_ + rowPixel - inset;
 
 		// For edge lines (row 0 and row == gridRows), always draw full line
 		if (row == 0 || row == config_.gridRows) {
-			painter.fillRect(gridOffsetX_ - inset, lineY, gridWidth_ + 2 * inset, lineThick, lineColor);
+			lines.append(QRect(gridOffsetX_ - inset, lineY, gridWidth_ + 2 * inset, lineThick));
 			continue;
 		}
 
@@ -526,7 +930,7 @@ void MultiviewWindow::paintEvent(QPaintEvent *event)
 				int endPixel = qRound(col * cellWidth_);
 				int x1 = gridOffsetX_ + startPixel - inset;
 				int segW = (endPixel - startPixel) + 2 * inset;
-				painter.fillRect(x1, lineY, segW, lineThick, lineColor);
+				lines.append(QRect(x1, lineY, segW, lineThick));
 				segmentStart = -1;
 			}
 		}
@@ -535,7 +939,31 @@ void MultiviewWindow::paintEvent(QPaintEvent *event)
 			int startPixel = qRound(segmentStart * cellWidth_);
 			int x1 = gridOffsetX_ + startPixel - inset;
 			int segW = (gridWidth_ - startPixel) + 2 * inset;
-			painter.fillRect(x1, lineY, segW, lineThick, lineColor);
+			lines.append(QRect(x1, lineY, segW, lineThick));
 		}
 	}
+
+	return lines;
+}
+
+void MultiviewWindow::paintEvent(QPaintEvent *event)
+{
+	QWidget::paintEvent(event);
+
+	if (config_.gridRows <= 0 || config_.gridCols <= 0)
+		return;
+
+	QPainter painter(this);
+	painter.setRenderHint(QPainter::Antialiasing, false);
+
+	// Fill background with black
+	painter.fillRect(rect(), Qt::black);
+
+	// The compositor draws grid lines itself over the whole window
+	if (compositor_)
+		return;
+
+	QColor lineColor = config_.gridLineColor;
+	for (const QRect &line : gridLineRects())
+		painter.fillRect(line, lineColor);
 }
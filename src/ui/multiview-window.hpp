@@ -20,17 +20,29 @@ with this program. If not, see <https://www.gnu.org/licenses/>
 
 #include <QWidget>
 #include <QVector>
+#include <QList>
 #include <QMap>
 #include <QString>
+#include <QTimer>
 
 #include "../core/multiview-config.hpp"
 #include "../render/multiview-renderer.hpp"
+#include "../render/multiview-compositor.hpp"
 
 /**
  * Top-level window that displays a multiview grid layout.
  * Manages cell surfaces and renderers. Labels and placeholder icons
  * are rendered by CellRenderer within the OBS graphics pipeline.
+ * In compositor mode a single surface and display cover the whole window
+ * and the grid lines are drawn on the GPU instead of by paintEvent.
  * Supports windowed and per-monitor fullscreen modes with state persistence.
+ * While the window is being resized the OBS displays keep their swap chain
+ * size and stretch; they are resized once, after the resize settles.
+ * The most recently closed windows are kept hidden, with their surfaces and
+ * OBS displays, and reused when the same multiview is opened again.
+ * Rendering is suspended while the window is hidden, minimized or not
+ * exposed (occluded, on platforms that report it), and so are live label
+ * token refreshes.
  */
 class MultiviewWindow : public QWidget {
 	Q_OBJECT
@@ -54,6 +66,10 @@ public:
 	static void reopenPreviouslyOpen();
 	static MultiviewWindow *findByName(const QString &name);
 
+	// Destroy the closed windows kept for reuse, and any still pending
+	// deletion (at exit, while the graphics subsystem is still up)
+	static void releasePool();
+
 protected:
 	void resizeEvent(QResizeEvent *event) override;
 	void moveEvent(QMoveEvent *event) override;
@@ -61,23 +77,52 @@ protected:
 	void contextMenuEvent(QContextMenuEvent *event) override;
 	void changeEvent(QEvent *event) override;
 	void paintEvent(QPaintEvent *event) override;
+	void showEvent(QShowEvent *event) override;
+	void hideEvent(QHideEvent *event) override;
+	bool eventFilter(QObject *watched, QEvent *event) override;
 
 private:
 	void buildGrid();
+	bool applyConfigIncrementally(const MultiviewConfig &old);
+	QWidget *createCellSurface();
+	void destroyGrid();
+	void retireRenderers(const QVector<CellRenderer *> &renderers);
 	void initRenderers();
-	void updateLayout();
+	void updateLayout(bool liveResize = false);
+	void onResizeSettled();
+	void updateRenderVisibility();
+	void updateLabelTimer();
+	void refreshLabels();
+	QVector<QRect> gridLineRects() const;
+	void captureWindowState();
 	void saveWindowState();
 	void openEditDialog();
 	void updateTitle();
+	void markOpen();
+	void reopen();
+	void restoreWindowState();
+	void recycle();
+	void dropFromPool();
+	void retire();
 	void calculateGridMetrics(int &gridW, int &gridH, int &offsetX, int &offsetY, float &cellW, float &cellH) const;
 
 	QString name_;
 	MultiviewConfig config_;
 	QVector<QWidget *> cellSurfaces_;
 	QVector<CellRenderer *> renderers_;
+	QWidget *compositorSurface_ = nullptr;
+	MultiviewCompositor *compositor_ = nullptr;
 	QString placeholderSvgPath_;
 	bool fullscreen_ = false;
 	bool updatingConfig_ = false;
+	bool renderVisible_ = true;
+	bool visibilityHooked_ = false;
+	QTimer *labelTimer_ = nullptr; // Re-expands live label tokens
+
+	// Interactive resizes and moves restart this; displays are resized and
+	// the window state saved once it fires
+	QTimer *settleTimer_ = nullptr;
+	bool resizePending_ = false;
 
 	// Cached grid metrics for painting
 	int gridOffsetX_ = 0;
@@ -88,4 +133,6 @@ private:
 	float cellHeight_ = 0;
 
 	static QMap<QString, MultiviewWindow *> openWindows_;
+	static QList<MultiviewWindow *> pooledWindows_;  // Closed, least recently first
+	static QList<MultiviewWindow *> retiredWindows_; // Pending deleteLater()
 };